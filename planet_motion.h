@@ -33,6 +33,14 @@
 extern "C" {
 #endif
 
+// host (gcc, clang) builds have no z88dk calling conventions
+
+#ifndef __Z88DK
+    #define __z88dk_fastcall
+    #define __z88dk_callee
+    #define __preserves_regs(...)
+#endif
+
 // numeric constants...
 
 #define METERS_PER_ASTRONOMICAL_UNIT        1.4959787e+11
@@ -48,6 +56,7 @@ extern "C" {
 
 #define SQRT        sqrt
 #define HYPOT       hypot
+#define POW         pow
 
 #define COS         cos
 #define SIN         sin
@@ -66,6 +75,40 @@ extern "C" {
 #define RAD(x)      ((x)*(M_PI/180.0))
 #define DEG(x)      ((x)*(180.0/M_PI))
 
+// host instrumentation counters of each body (planet_motion_profile.c), compiled out unless PLANET_MOTION_PROFILE
+
+#define PROFILE_POSITIONS   0       // sun, planet and stepper positions solved
+#define PROFILE_KEPLER      1       // eccentricAnomaly() calls
+#define PROFILE_NEWTON      2       // Newton iterations of every Kepler solver
+#define PROFILE_REV         3       // rev() calls
+#define PROFILE_TRIG        4       // SIND(), COSD(), SINCOSD() and ATAN2D() invocations
+
+#define PROFILE_COUNTERS    5
+
+#ifdef PLANET_MOTION_PROFILE
+    #define PROFILE_BODY(p)     profileBody = profileIndex(p);      // a whole statement, so it can come before declarations
+    #define PROFILE_COUNT(c)    (++profileCount[profileBody][c])
+    #define PROFILED(c,e)       (PROFILE_COUNT(c), (e))
+#else
+    #define PROFILE_BODY(p)
+    #define PROFILE_COUNT(c)
+    #define PROFILED(c,e)       (e)
+#endif
+
+// trigonometry in degrees, optionally from planet_motion_trig.c
+
+#ifdef PLANET_MOTION_DEGREES
+    #define SIND(x)         PROFILED(PROFILE_TRIG, sind(x))
+    #define COSD(x)         PROFILED(PROFILE_TRIG, cosd(x))
+    #define SINCOSD(x,s,c)  PROFILED(PROFILE_TRIG, sincosd((x),(s),(c)))
+    #define ATAN2D(y,x)     PROFILED(PROFILE_TRIG, atan2d((y),(x)))
+#else
+    #define SIND(x)         PROFILED(PROFILE_TRIG, SIN(RAD(x)))
+    #define COSD(x)         PROFILED(PROFILE_TRIG, COS(RAD(x)))
+    #define SINCOSD(x,s,c)  PROFILED(PROFILE_TRIG, (*(s) = SIN(RAD(x)), *(c) = COS(RAD(x))))
+    #define ATAN2D(y,x)     PROFILED(PROFILE_TRIG, DEG(ATAN2((y),(x))))
+#endif
+
 // type definitions
 
 typedef struct cartesian_coordinates_s {
@@ -87,6 +130,41 @@ typedef struct planet_s {   // See  http://www.stjarnhimlen.se/comp/ppcomp.html#
     FLOAT radius;           // radius proportional to earth's radius (earth = 1.0)
 } planet_t;
 
+// planetary constants (planet_motion_bodies.c)
+
+#define PLANETS     9
+
+extern const planet_t sun, moon, mercury, venus, mars, jupiter, saturn, uranus, neptune;
+extern const planet_t * const planets[PLANETS];
+
+// Kepler's equation is solved to corrections below KEPLER_TOLERANCE. The planet_motion_kepler.c solvers,
+// the steppers, the vector kernels and planet_motion_fixed.c stop after at most KEPLER_ITERATIONS_MAX,
+// eccentricAnomaly() iterates until the tolerance is met.
+
+#define KEPLER_TOLERANCE        1.0e-3      // degrees
+#define KEPLER_ITERATIONS_MAX   8
+
+// host benchmark counter of eccentricAnomaly Newton iterations
+
+#ifdef PLANET_MOTION_COUNT
+    extern uint32_t eccentricAnomalyIterations;
+    #ifdef PLANET_MOTION_PROFILE
+        #define COUNT_ITERATION()   (++eccentricAnomalyIterations, PROFILE_COUNT(PROFILE_NEWTON))
+    #else
+        #define COUNT_ITERATION()   (++eccentricAnomalyIterations)
+    #endif
+#else
+    #define COUNT_ITERATION()   PROFILE_COUNT(PROFILE_NEWTON)
+#endif
+
+// host instrumentation counters, by index in planets[], or PLANETS for any other body
+
+#ifdef PLANET_MOTION_PROFILE
+    extern uint8_t profileBody;
+    extern uint32_t profileCount[PLANETS + 1][PROFILE_COUNTERS];
+    uint8_t profileIndex (const planet_t * planet);    // of planet, or of sun when NULL
+#endif
+
 // utility functions (C)
 
 void sunEclipticCartesianCoordinates ( cartesian_coordinates_t * sun ) __z88dk_fastcall;
@@ -94,6 +172,13 @@ void planetEclipticCartesianCoordinates ( cartesian_coordinates_t * location, co
 FLOAT eccentricAnomaly (FLOAT e, FLOAT M) __z88dk_callee;
 void addCartesianCoordinates ( cartesian_coordinates_t * base, const cartesian_coordinates_t * addend ) __z88dk_callee;
 
+// degree trigonometry functions (C)
+
+FLOAT sind (FLOAT x) __z88dk_fastcall;
+FLOAT cosd (FLOAT x) __z88dk_fastcall;
+void sincosd (FLOAT x, FLOAT * s, FLOAT * c);
+FLOAT atan2d (FLOAT y, FLOAT x) __z88dk_callee;
+
 // utility functions (C or assembly)
 
 FLOAT rev (FLOAT x) __z88dk_fastcall;
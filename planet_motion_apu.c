@@ -0,0 +1,115 @@
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_apu.h"
+#include "multi_apu.h"
+
+// Am9511A data sheet execution times in clock cycles, the mean of the minimum and maximum,
+// with the data port transfers of push and pop
+
+const char * const apuOpNames[APU_OPS] = { "push", "pop", "fadd", "fmul", "fdiv", "sin", "cos", "tan", "asin", "acos", "atan" };
+const uint16_t apuOpCycles[APU_OPS] = { 16, 16, 203, 168, 171, 4302, 4360, 5390, 7084, 7294, 5764 };
+
+apu_t apu;
+
+void apuReset ( void )
+{
+    memset(&apu, 0, sizeof(apu));
+}
+
+// hold the Z80 until the unit is done
+static void apuWait (apu_unit_t * unit)
+{
+    if (apu.now < unit->ready) {
+        apu.wait += unit->ready - apu.now;
+        apu.now = unit->ready;
+    }
+}
+
+// run an opcode on the unit, from when it is issued
+static void apuRun (apu_unit_t * unit, uint8_t op)
+{
+    uint64_t cycles = (uint64_t)apuOpCycles[op] * APU_Z80_CLOCK / APU_CLOCK;
+
+    unit->ready = apu.now + cycles;
+    unit->busy += cycles;
+    ++unit->ops[op];
+}
+
+static void apuPush (uint8_t n, float x)
+{
+    apu_unit_t * unit = &apu.unit[n];
+
+    apuWait(unit);
+    unit->top = (unit->top + 1) & (APU_STACK-1);                    // the stack wraps, as the chip's does
+    unit->stack[unit->top] = x;
+    apuRun(unit, APU_PUSH);
+    apu.now += APU_Z80_PUSH;
+}
+
+static float apuPop (uint8_t n)
+{
+    apu_unit_t * unit = &apu.unit[n];
+    float x;
+
+    apuWait(unit);
+    x = unit->stack[unit->top];
+    unit->top = (unit->top - 1) & (APU_STACK-1);
+    apuRun(unit, APU_POP);
+    apu.now += APU_Z80_POP;
+    return x;
+}
+
+// issue a command, which replaces the top of stack (and next on stack, for the arithmetic)
+static void apuCommand (uint8_t n, uint8_t op)
+{
+    apu_unit_t * unit = &apu.unit[n];
+    float * tos, nos;
+
+    apuWait(unit);
+    tos = &unit->stack[unit->top];
+
+    switch (op) {
+        case APU_FADD:
+        case APU_FMUL:
+        case APU_FDIV:
+            unit->top = (unit->top - 1) & (APU_STACK-1);
+            nos = unit->stack[unit->top];
+            unit->stack[unit->top] = op == APU_FADD ? nos + *tos : op == APU_FMUL ? nos * *tos : nos / *tos;
+            break;
+        case APU_SIN:  *tos = sinf(*tos);  break;
+        case APU_COS:  *tos = cosf(*tos);  break;
+        case APU_TAN:  *tos = tanf(*tos);  break;
+        case APU_ASIN: *tos = asinf(*tos); break;
+        case APU_ACOS: *tos = acosf(*tos); break;
+        case APU_ATAN: *tos = atanf(*tos); break;
+    }
+
+    apu.now += APU_Z80_COMMAND;
+    apuRun(unit, op);
+}
+
+// the multi_apu.asm functions of unit n
+
+#define APU_FUNCTIONS(n) \
+    float pop_##n (void) { return apuPop(n); } \
+    void push_##n (float x) { apuPush(n, x); } \
+    void add_##n (float y) { apuPush(n, y); apuCommand(n, APU_FADD); } \
+    void mul_##n (float y) { apuPush(n, y); apuCommand(n, APU_FMUL); } \
+    void div_##n (float y) { apuPush(n, y); apuCommand(n, APU_FDIV); } \
+    void sin_##n (void) { apuCommand(n, APU_SIN); } \
+    void cos_##n (void) { apuCommand(n, APU_COS); } \
+    void tan_##n (void) { apuCommand(n, APU_TAN); } \
+    void asin_##n (float x) { apuPush(n, x); apuCommand(n, APU_ASIN); } \
+    void acos_##n (float x) { apuPush(n, x); apuCommand(n, APU_ACOS); } \
+    void atan_##n (float x) { apuPush(n, x); apuCommand(n, APU_ATAN); } \
+    void rad_##n (float x) { apuPush(n, x); apuPush(n, (float)(M_PI/180.0)); apuCommand(n, APU_FMUL); } \
+    void deg_##n (void) { apuPush(n, (float)(180.0/M_PI)); apuCommand(n, APU_FMUL); }
+
+APU_FUNCTIONS(0)
+APU_FUNCTIONS(1)
+APU_FUNCTIONS(2)
+APU_FUNCTIONS(3)
@@ -0,0 +1,106 @@
+/*
+ * planet_motion_apu.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_APU_H
+#define _PLANET_MOTION_APU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host (gcc, clang) emulation of four Am9511A APUs behind the multi_apu.h functions, so that
+// planet_motion_mapu.c can be run, checked and timed without the hardware.
+//
+// Each unit has the chip's 4 float stack, and runs each command for its data sheet cycle count
+// after it is issued. The Z80 issues commands without waiting, but a push, command or pop to a
+// unit that is still busy waits until it is done, as the chip holds the Z80 with PAUSE.
+// Only the Z80 time of the APU accesses is counted, not that of the C code between them.
+
+#define APU_UNITS           4
+#define APU_STACK           4
+
+#define APU_Z80_CLOCK       7372800         // Hz
+#define APU_CLOCK           3686400         // Hz, so a chip cycle is 2 Z80 T-states
+
+#define APU_Z80_PUSH        110             // T-states to push a float, from fastcall to ret
+#define APU_Z80_POP         120             // T-states to pop a float
+#define APU_Z80_COMMAND     45              // T-states to issue a command
+
+// opcodes counted
+
+#define APU_PUSH    0
+#define APU_POP     1
+#define APU_FADD    2
+#define APU_FMUL    3
+#define APU_FDIV    4
+#define APU_SIN     5
+#define APU_COS     6
+#define APU_TAN     7
+#define APU_ASIN    8
+#define APU_ACOS    9
+#define APU_ATAN    10
+
+#define APU_OPS     11
+
+// type definitions
+
+typedef struct apu_unit_s {         // an Am9511A
+    float stack[APU_STACK];
+    uint8_t top;
+    uint64_t ready;         // T-state the last command completes.
+    uint64_t busy;          // T-states running commands.
+    uint32_t ops[APU_OPS];  // commands, pushes and pops.
+} apu_unit_t;
+
+typedef struct apu_s {              // four APUs, and the Z80 using them
+    apu_unit_t unit[APU_UNITS];
+    uint64_t now;           // Z80 T-states.
+    uint64_t wait;          // Z80 T-states held waiting on a busy unit.
+} apu_t;
+
+extern apu_t apu;
+
+extern const char * const apuOpNames[APU_OPS];
+extern const uint16_t apuOpCycles[APU_OPS];     // Am9511A clock cycles of each opcode
+
+// APU emulation functions (C)
+
+// Empty the stacks, and clear the time and counts.
+void apuReset ( void );
+
+// The functions of planet_motion_mapu.c, as built for the host by the Makefile.
+void apuSunEclipticCartesianCoordinates ( cartesian_coordinates_t * sun );
+void apuPlanetEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const planet_t * planet );
+FLOAT apuEccentricAnomaly ( FLOAT e, FLOAT M );
+void apuAddCartesianCoordinates ( cartesian_coordinates_t * base, const cartesian_coordinates_t * addend );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_APU_H  */
@@ -0,0 +1,153 @@
+/*
+ * planet_motion_apu_bench.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host check and timing of planet_motion_mapu.c on four emulated Am9511A APUs.
+
+    build and run with:
+
+    make
+    ./planet_motion_apu_bench [start_day] [days]
+
+    Each body is computed by planet_motion_mapu.c, on the emulated APUs, and by planet_motion_fns.c
+    over the days, reporting the largest difference, and the Z80 time per call with the time each
+    unit was busy and the Z80 waited. The overlap is the sum of the unit busy times over the
+    elapsed time, 1.0 when the units only ever run one at a time.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_apu.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+
+static uint32_t ops[APU_OPS];
+
+static void collect (void)
+{
+    uint8_t n, op;
+
+    for (n = 0; n < APU_UNITS; ++n)
+        for (op = 0; op < APU_OPS; ++op)
+            ops[op] += apu.unit[n].ops[op];
+}
+
+static void report (const char * function, const char * body, double error, uint32_t calls)
+{
+    uint64_t busy = 0;
+    uint8_t n;
+
+    for (n = 0; n < APU_UNITS; ++n)
+        busy += apu.unit[n].busy;
+
+    printf("%-36s %-8s %10.2e %9.0f %8.2f", function, body, error, (double)apu.now / calls, apu.now * 1.0e3 / APU_Z80_CLOCK / calls);
+    for (n = 0; n < APU_UNITS; ++n)
+        printf(" %5.1f", 100.0 * apu.unit[n].busy / apu.now);
+    printf(" %6.1f %7.2f\n", 100.0 * apu.wait / apu.now, (double)busy / apu.now);
+    collect();
+}
+
+static double difference (const cartesian_coordinates_t * a, const cartesian_coordinates_t * b)
+{
+    double d = fabs(a->x - b->x);
+
+    if (fabs(a->y - b->y) > d) d = fabs(a->y - b->y);
+    if (fabs(a->z - b->z) > d) d = fabs(a->z - b->z);
+    return d;
+}
+
+int main (int argc, char ** argv)
+{
+    cartesian_coordinates_t reference, location;
+    double error;
+    uint16_t d;
+    uint8_t p, op;
+
+    if (argc > 1) startDay = (uint16_t)atoi(argv[1]);
+    if (argc > 2) days = (uint16_t)atoi(argv[2]);
+    if (argc > 3 || days == 0) {
+        fprintf(stderr, "usage: %s [start_day] [days]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%u days from day %u, Z80 at %.4f MHz, APUs at %.4f MHz\n\n", days, startDay, APU_Z80_CLOCK / 1.0e6, APU_CLOCK / 1.0e6);
+    printf("%-36s %-8s %10s %9s %8s %5s %5s %5s %5s %6s %7s\n", "function", "body", "error", "T/call", "ms/call", "apu0%", "apu1%", "apu2%", "apu3%", "wait%", "overlap");
+
+    apuReset();
+    error = 0.0;
+    for (d = 0; d < days; ++d) {
+        reference.day = location.day = startDay + d;
+        sunEclipticCartesianCoordinates(&reference);
+        apuSunEclipticCartesianCoordinates(&location);
+        if (difference(&reference, &location) > error)
+            error = difference(&reference, &location);
+    }
+    report("sunEclipticCartesianCoordinates", "sun", error, days);
+
+    for (p = 1; p < PLANETS; ++p) {
+        apuReset();
+        error = 0.0;
+        for (d = 0; d < days; ++d) {
+            reference.day = location.day = startDay + d;
+            planetEclipticCartesianCoordinates(&reference, planets[p]);
+            apuPlanetEclipticCartesianCoordinates(&location, planets[p]);
+            if (difference(&reference, &location) > error)
+                error = difference(&reference, &location);
+        }
+        report("planetEclipticCartesianCoordinates", planets[p]->name, error, days);
+    }
+
+    for (p = 1; p < PLANETS; ++p) {
+        const planet_t * planet = planets[p];
+
+        apuReset();
+        error = 0.0;
+        for (d = 0; d < days; ++d) {
+            FLOAT day = startDay + d;
+            FLOAT e = planet->e0 + day * planet->ec;
+            FLOAT M = rev(planet->M0 + day * planet->Mc);
+            FLOAT E = eccentricAnomaly(e, M) - apuEccentricAnomaly(e, M);
+
+            if (fabs(E) > error)
+                error = fabs(E);
+        }
+        report("eccentricAnomaly (deg)", planet->name, error, days);
+    }
+
+    printf("\n%-8s %12s %10s %14s\n", "opcode", "count", "cycles", "total cycles");
+    for (op = 0; op < APU_OPS; ++op)
+        printf("%-8s %12u %10u %14.0f\n", apuOpNames[op], ops[op], apuOpCycles[op], (double)ops[op] * apuOpCycles[op]);
+    return 0;
+}
@@ -0,0 +1,152 @@
+
+#include <stdint.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_batch.h"
+#include "planet_motion_simd.h"
+
+// The batch functions work through BATCH_DAYS days at a time, one stage at a time,
+// so that each stage is a tight loop over contiguous arrays that the compiler can vectorise.
+// All of the arithmetic is done in FLOAT, so the constants are FLOAT too.
+// The trigonometry and Kepler stages run on the kernels chosen by simdKernels().
+
+#if defined(__MATH_MATH32) || defined(__MATH_AM9511)
+    #define REV(x)  rev(x)
+#else
+    #define REV(x)  ((x) - FLOOR((x)*(FLOAT)(1/360.0))*(FLOAT)360.0)
+#endif
+
+void sunEclipticCartesianBatch ( cartesian_table_t * table, FLOAT day, uint16_t days )
+{
+    const simd_kernels_t * kernels = simdKernels();
+    FLOAT T[BATCH_DAYS], L0[BATCH_DAYS], M0[BATCH_DAYS], C[BATCH_DAYS], e[BATCH_DAYS];
+    FLOAT M2[BATCH_DAYS], M3[BATCH_DAYS], sinv[BATCH_DAYS], cosv[BATCH_DAYS];
+    FLOAT sinM0[BATCH_DAYS], sin2M0[BATCH_DAYS], sin3M0[BATCH_DAYS];
+    uint16_t start, k, n;
+
+    for (start = 0; start < days; start += n) {
+        FLOAT * x = table->x + start;
+        FLOAT * y = table->y + start;
+        FLOAT * z = table->z + start;
+        FLOAT * au = table->au + start;
+
+        n = (days - start) < BATCH_DAYS ? (days - start) : BATCH_DAYS;
+
+        for (k = 0; k < n; ++k) {                                   // Sun's mean longitude and mean anomaly, in degrees
+            // evaluated in double, and rounded to FLOAT, as sunEclipticCartesianCoordinates() does
+            double t = T[k] = (FLOAT)(((double)day + (start + k) - 1.5) * 0.0000273785);   // Julian centuries since J2000.0
+
+            L0[k] = (FLOAT)(280.46645 + (36000.76983 * t) + (0.0003032 * t * t));
+            M0[k] = (FLOAT)(357.52910 + (35999.05030 * t) - (0.0001559 * t * t) - (0.00000048 * t * t * t));
+        }
+
+        for (k = 0; k < n; ++k) {
+            L0[k] = REV(L0[k]);
+            M0[k] = REV(M0[k]);
+        }
+
+        for (k = 0; k < n; ++k) {                                   // The eccentricity of the Earth's orbit
+            e[k] = (FLOAT)0.016708617 - T[k] * ((FLOAT)0.000042037 + T[k] * (FLOAT)0.0000001236);
+        }
+
+        for (k = 0; k < n; ++k) {
+            M2[k] = 2 * M0[k];
+            M3[k] = 3 * M0[k];
+        }
+
+        kernels->sincosd(sinM0, cosv, M0, n);                      // only the sines are needed
+        kernels->sincosd(sin2M0, cosv, M2, n);
+        kernels->sincosd(sin3M0, cosv, M3, n);
+
+        for (k = 0; k < n; ++k) {                                   // Sun's equation of center in degrees
+            FLOAT T_SQR = T[k] * T[k];
+            C[k] = ((FLOAT)1.914600 - (FLOAT)0.004817 * T[k] - (FLOAT)0.000014 * T_SQR) * sinM0[k]
+                 + ((FLOAT)0.01993 - (FLOAT)0.000101 * T[k]) * sin2M0[k]
+                 + (FLOAT)0.000290 * sin3M0[k];
+        }
+
+        for (k = 0; k < n; ++k) {
+            M0[k] += C[k];                                          // Sun's true anomaly
+            L0[k] += C[k];                                          // true ecliptical longitude of Sun
+        }
+
+        kernels->sincosd(sinv, cosv, M0, n);
+        kernels->sincosd(y, x, L0, n);
+
+        for (k = 0; k < n; ++k) {                                   // distance from Sun to Earth in AU
+            au[k] = ((FLOAT)1.000001018 * (1 - e[k] * e[k])) / (1 + e[k] * cosv[k]);
+            x[k] *= au[k];
+            y[k] *= au[k];
+            z[k] = 0.0;
+        }
+    }
+}
+
+void planetEclipticCartesianBatch ( cartesian_table_t * table, const planet_t * const * planet, uint8_t count, FLOAT day, uint16_t days )
+{
+    const simd_kernels_t * kernels = simdKernels();
+    FLOAT N[BATCH_DAYS], i[BATCH_DAYS], w[BATCH_DAYS], a[BATCH_DAYS], e[BATCH_DAYS], M[BATCH_DAYS], E[BATCH_DAYS];
+    FLOAT cosE[BATCH_DAYS], sinE[BATCH_DAYS], xv[BATCH_DAYS], yv[BATCH_DAYS];
+    FLOAT cosN[BATCH_DAYS], sinN[BATCH_DAYS], cosi[BATCH_DAYS], sini[BATCH_DAYS], cosw[BATCH_DAYS], sinw[BATCH_DAYS];
+    uint16_t start, k, n;
+    uint8_t p;
+
+    for (p = 0; p < count; ++p) {
+        const planet_t * body = planet[p];
+
+        for (start = 0; start < days; start += n) {
+            uint32_t row = (uint32_t)p * days + start;
+            FLOAT * x = table->x + row;
+            FLOAT * y = table->y + row;
+            FLOAT * z = table->z + row;
+            FLOAT * au = table->au + row;
+
+            n = (days - start) < BATCH_DAYS ? (days - start) : BATCH_DAYS;
+
+            for (k = 0; k < n; ++k) {                               // orbital elements for each day
+                FLOAT d = day + (FLOAT)(start + k);
+                N[k] = body->N0 + (d * body->Nc);
+                i[k] = body->i0 + (d * body->ic);
+                w[k] = body->w0 + (d * body->wc);
+                a[k] = body->a0 + (d * body->ac);
+                e[k] = body->e0 + (d * body->ec);
+                M[k] = body->M0 + (d * body->Mc);
+            }
+
+            for (k = 0; k < n; ++k) {                               // a and e are never outside [0,360)
+                N[k] = REV(N[k]);
+                i[k] = REV(i[k]);
+                w[k] = REV(w[k]);
+                M[k] = REV(M[k]);
+            }
+
+            kernels->kepler(E, e, M, n);
+            kernels->sincosd(sinE, cosE, E, n);
+
+            for (k = 0; k < n; ++k) {                               // position in the orbital plane
+                xv[k] = a[k] * (cosE[k] - e[k]);
+                yv[k] = a[k] * SQRT(1 - e[k] * e[k]) * sinE[k];
+            }
+
+            for (k = 0; k < n; ++k) {                               // distance from the Sun in AU
+                au[k] = SQRT(xv[k] * xv[k] + yv[k] * yv[k]);
+            }
+
+            kernels->sincosd(sinN, cosN, N, n);
+            kernels->sincosd(sini, cosi, i, n);
+            kernels->sincosd(sinw, cosw, w, n);
+
+            for (k = 0; k < n; ++k) {
+                // The true anomaly v is the angle of (xv, yv), so r*cos(v+w) and r*sin(v+w)
+                // follow from the angle sum identities without an ATAN2, or a trig call on v+w.
+                FLOAT rcosVW = xv[k] * cosw[k] - yv[k] * sinw[k];
+                FLOAT rsinVW = yv[k] * cosw[k] + xv[k] * sinw[k];
+
+                x[k] = cosN[k] * rcosVW - sinN[k] * rsinVW * cosi[k];
+                y[k] = sinN[k] * rcosVW + cosN[k] * rsinVW * cosi[k];
+                z[k] = rsinVW * sini[k];
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * planet_motion_batch.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_BATCH_H
+#define _PLANET_MOTION_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// days computed together through each stage of the batch functions
+
+#define BATCH_DAYS  64
+
+// type definitions
+
+typedef struct cartesian_table_s {  // structure of arrays, each indexed [body * days + day]
+    FLOAT * x;
+    FLOAT * y;
+    FLOAT * z;
+    FLOAT * au;             // radius in AU
+} cartesian_table_t;
+
+// batch functions (C)
+
+// Sun (seen from Earth) for the days [day, day+days), into rows of length days.
+void sunEclipticCartesianBatch ( cartesian_table_t * table, FLOAT day, uint16_t days );
+
+// Each of count planets for the days [day, day+days), planet p into the row [p * days].
+// The results agree with planetEclipticCartesianCoordinates() to within FLOAT rounding.
+void planetEclipticCartesianBatch ( cartesian_table_t * table, const planet_t * const * planet, uint8_t count, FLOAT day, uint16_t days );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_BATCH_H  */
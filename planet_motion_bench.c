@@ -0,0 +1,643 @@
+/*
+ * planet_motion_bench.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host benchmark of the planet motion utility functions.
+
+    build and run with:
+
+    make bench
+
+    planet_motion_bench [start_day] [days] [repeat]
+
+    Each function is timed per body over days [start_day, start_day+days),
+    and the day range is repeated to get a stable measurement.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_batch.h"
+#include "planet_motion_simd.h"
+#include "planet_motion_kepler.h"
+#include "planet_motion_state.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+#define REPEAT              20
+
+volatile FLOAT sink;                                                // defeat dead code elimination
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+static uint16_t repeat = REPEAT;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static void report (const char * function, const char * body, double ns, uint32_t calls, uint32_t iterations, uint32_t iterationsMax)
+{
+    printf("%-40s %-8s %9u %10.1f %12.0f", function, body, calls, ns/calls, calls*1.0e9/ns);
+    if (iterations)
+        printf(" %9.2f", (double)iterations/calls);
+    if (iterationsMax)
+        printf(" %8u", iterationsMax);
+    printf("\n");
+}
+
+static void benchSun (void)
+{
+    cartesian_coordinates_t location;
+    uint32_t calls = 0;
+    double start;
+    uint16_t r, d;
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = startDay; d < startDay+days; ++d) {
+            location.day = d;
+            sunEclipticCartesianCoordinates(&location);
+            sink = location.x;
+            ++calls;
+        }
+    }
+    report("sunEclipticCartesianCoordinates", "Sun", now()-start, calls, 0, 0);
+}
+
+static void benchPlanet (const planet_t * planet)
+{
+    cartesian_coordinates_t location;
+    uint32_t calls = 0;
+    uint32_t iterations, iterationsMax = 0;
+    double start;
+    uint16_t r, d;
+
+    for (d = startDay; d < startDay+days; ++d) {                    // untimed pass for the worst case iterations
+        eccentricAnomalyIterations = 0;
+        location.day = d;
+        planetEclipticCartesianCoordinates(&location, planet);
+        if (eccentricAnomalyIterations > iterationsMax)
+            iterationsMax = eccentricAnomalyIterations;
+    }
+
+    eccentricAnomalyIterations = 0;
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = startDay; d < startDay+days; ++d) {
+            location.day = d;
+            planetEclipticCartesianCoordinates(&location, planet);
+            sink = location.x;
+            ++calls;
+        }
+    }
+    iterations = eccentricAnomalyIterations;
+    report("planetEclipticCartesianCoordinates", planet->name, now()-start, calls, iterations, iterationsMax);
+}
+
+static FLOAT benchState (const planet_t * planet)
+{
+    planet_state_t state;
+    cartesian_coordinates_t location, reference;
+    FLOAT error, errorMax = 0.0;
+    uint32_t calls = 0;
+    double start;
+    uint16_t r, d;
+
+    planetStateInit(&state, planet, PLANET_STATE_TOLERANCE);
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = startDay; d < startDay+days; ++d) {
+            location.day = d;
+            planetStateEclipticCartesianCoordinates(&location, &state);
+            sink = location.x;
+            ++calls;
+        }
+    }
+    report("planetStateEclipticCartesianCoordinates", planet->name, now()-start, calls, 0, 0);
+
+    for (d = startDay; d < startDay+days; ++d) {
+        location.day = reference.day = d;
+        planetStateEclipticCartesianCoordinates(&location, &state);
+        planetEclipticCartesianCoordinates(&reference, planet);
+        error = SQRT(SQR(location.x - reference.x) + SQR(location.y - reference.y) + SQR(location.z - reference.z));
+        if (error > errorMax)
+            errorMax = error;
+    }
+    return errorMax;
+}
+
+static FLOAT benchStepper (const planet_t * planet)
+{
+    planet_stepper_t stepper;
+    sun_stepper_t sunStepper;
+    cartesian_coordinates_t location, reference;
+    FLOAT error, errorMax = 0.0;
+    uint32_t calls = 0;
+    uint32_t iterations;
+    double start;
+    uint16_t r, d;
+
+    eccentricAnomalyIterations = 0;
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        if (planet == NULL)
+            sunStepperInit(&sunStepper, startDay, 1.0, STEPPER_RENORMALISE);
+        else
+            planetStepperInit(&stepper, planet, startDay, 1.0, STEPPER_RENORMALISE);
+
+        for (d = startDay; d < startDay+days; ++d) {
+            location.day = d;
+            if (planet == NULL)
+                sunStepperEclipticCartesianCoordinates(&location, &sunStepper);
+            else
+                planetStepperEclipticCartesianCoordinates(&location, &stepper);
+            sink = location.x;
+            ++calls;
+        }
+    }
+    iterations = eccentricAnomalyIterations;
+    report(planet ? "planetStepperEclipticCartesianCoordinates" : "sunStepperEclipticCartesianCoordinates",
+            planet ? planet->name : "Sun", now()-start, calls, iterations, 0);
+
+    if (planet == NULL)
+        sunStepperInit(&sunStepper, startDay, 1.0, STEPPER_RENORMALISE);
+    else
+        planetStepperInit(&stepper, planet, startDay, 1.0, STEPPER_RENORMALISE);
+
+    for (d = startDay; d < startDay+days; ++d) {
+        location.day = reference.day = d;
+        if (planet == NULL) {
+            sunStepperEclipticCartesianCoordinates(&location, &sunStepper);
+            sunEclipticCartesianCoordinates(&reference);
+        } else {
+            planetStepperEclipticCartesianCoordinates(&location, &stepper);
+            planetEclipticCartesianCoordinates(&reference, planet);
+        }
+        error = SQRT(SQR(location.x - reference.x) + SQR(location.y - reference.y) + SQR(location.z - reference.z));
+        if (error > errorMax)
+            errorMax = error;
+    }
+    return errorMax;
+}
+
+static void benchEccentricAnomaly (const planet_t * planet)
+{
+    FLOAT * e = malloc(days * sizeof(FLOAT));
+    FLOAT * M = malloc(days * sizeof(FLOAT));
+    uint32_t calls = 0;
+    uint32_t iterations, iterationsMax = 0;
+    double start;
+    uint16_t r, d;
+
+    if (e == NULL || M == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    for (d = 0; d < days; ++d) {                                    // the elements, as planetEclipticCartesianCoordinates sees them
+        e[d] = rev( planet->e0 + ((startDay+d) * planet->ec) );
+        M[d] = rev( planet->M0 + ((startDay+d) * planet->Mc) );
+
+        eccentricAnomalyIterations = 0;
+        sink = eccentricAnomaly(e[d], M[d]);
+        if (eccentricAnomalyIterations > iterationsMax)
+            iterationsMax = eccentricAnomalyIterations;
+    }
+
+    eccentricAnomalyIterations = 0;
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = 0; d < days; ++d) {
+            sink = eccentricAnomaly(e[d], M[d]);
+            ++calls;
+        }
+    }
+    iterations = eccentricAnomalyIterations;
+    report("eccentricAnomaly", planet->name, now()-start, calls, iterations, iterationsMax);
+
+    free(e);
+    free(M);
+}
+
+static void benchSky (void)
+{
+    sky_t sky;
+    cartesian_coordinates_t sun, location;
+    uint32_t calls = 0;
+    double start;
+    uint16_t r, d;
+    uint8_t p;
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = startDay; d < startDay+days; ++d) {                // as main() did, one body at a time
+            sun.day = d;
+            sunEclipticCartesianCoordinates(&sun);
+            for (p = 0; p < PLANETS; ++p) {
+                location.day = d;
+                planetEclipticCartesianCoordinates(&location, planets[p]);
+                addCartesianCoordinates(&location, &sun);
+                sink = location.x;
+            }
+            ++calls;
+        }
+    }
+    report("sun, planet and addCartesianCoordinates", "all", now()-start, calls, 0, 0);
+
+    calls = 0;
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        skyInit(&sky, planets, PLANETS, startDay, 1.0);
+        for (d = startDay; d < startDay+days; ++d) {
+            skyCoordinates(&sky, d);
+            sink = sky.geo[PLANETS-1].x;
+            ++calls;
+        }
+    }
+    report("skyCoordinates", "all", now()-start, calls, 0, 0);
+    printf("\n");
+}
+
+// E for M (deg) in double, to check the solvers against
+static double eccentricAnomalyReference (double e, double M)
+{
+    double E = M * (M_PI/180.0);
+    uint8_t i;
+
+    for (i = 0; i < 32; ++i)
+        E -= (E - e * sin(E) - M * (M_PI/180.0)) / (1.0 - e * cos(E));
+    return E * (180.0/M_PI);
+}
+
+static double benchKepler (const planet_t * planet, uint8_t method)
+{
+    kepler_solver_t solver;
+    char function[40];
+    double error, errorMax = 0.0;
+    double start;
+    FLOAT e, M;
+    uint16_t r, d;
+
+    keplerSolverInit(&solver, method, planet->e0 + startDay * planet->ec, KEPLER_TOLERANCE);
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = startDay; d < startDay+days; ++d) {
+            e = planet->e0 + (d * planet->ec);
+            M = rev( planet->M0 + (d * planet->Mc) );
+            sink = keplerSolve(&solver, e, M);
+        }
+    }
+    snprintf(function, sizeof(function), "keplerSolve %s", keplerSolverNames[method]);
+    if (method == KEPLER_FIXED)
+        snprintf(function, sizeof(function), "keplerSolve %s %u", keplerSolverNames[method], solver.fixed);
+    report(function, planet->name, now()-start, solver.calls, solver.iterations, solver.iterationsMax);
+
+    for (d = startDay; d < startDay+days; ++d) {
+        e = planet->e0 + (d * planet->ec);
+        M = rev( planet->M0 + (d * planet->Mc) );
+        error = fabs(keplerSolve(&solver, e, M) - eccentricAnomalyReference(e, M));
+        if (error > errorMax)
+            errorMax = error;
+    }
+    return errorMax;
+}
+
+static void benchAddCartesianCoordinates (void)
+{
+    cartesian_coordinates_t base = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    cartesian_coordinates_t addend = { 1.0e-3, -1.0e-3, 1.0e-4, 0.0, 0.0 };
+    uint32_t calls = 0;
+    double start;
+    uint16_t r, d;
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = 0; d < days; ++d) {
+            addCartesianCoordinates(&base, &addend);
+            ++calls;
+        }
+    }
+    sink = base.x;
+    report("addCartesianCoordinates", "-", now()-start, calls, 0, 0);
+}
+
+static void benchRev (void)
+{
+    uint32_t calls = 0;
+    double start;
+    uint16_t r, d;
+    uint8_t p;
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = startDay; d < startDay+days; ++d) {
+            for (p = 0; p < PLANETS; ++p) {
+                sink = rev( planets[p]->M0 + (d * planets[p]->Mc) );
+                ++calls;
+            }
+        }
+    }
+    report("rev", "-", now()-start, calls, 0, 0);
+}
+
+// track the largest errors of sincosd() and atan2d() at x against the library functions
+static void trigError (FLOAT x, FLOAT * errorSin, FLOAT * errorAtan)
+{
+    FLOAT s, c;
+
+    sincosd(x, &s, &c);
+    if (FABS(s - SIN(RAD(x))) > *errorSin) *errorSin = FABS(s - SIN(RAD(x)));
+    if (FABS(c - COS(RAD(x))) > *errorSin) *errorSin = FABS(c - COS(RAD(x)));
+    if (FABS(atan2d(s, c) - DEG(ATAN2(s, c))) > *errorAtan) *errorAtan = FABS(atan2d(s, c) - DEG(ATAN2(s, c)));
+}
+
+static void benchTrig (void)
+{
+    static const FLOAT edges[] = { -1.0e-7, -1.0e-6, -3.0e-6, 0.0, 90.0, 270.0, 360.0, 720.0 - 1.0/16384 };   // rounding at the quadrant and revolution edges
+
+    FLOAT * x = malloc(days * sizeof(FLOAT));
+    FLOAT s, c, errorSin = 0.0, errorAtan = 0.0;
+    uint32_t calls = 0;
+    double start;
+    uint16_t r, d;
+
+    if (x == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    for (d = 0; d < days; ++d) {                                    // angles spread over [0,360) and beyond
+        x[d] = rev( planets[d % PLANETS]->M0 + ((startDay+d) * planets[d % PLANETS]->Mc) ) + (d % 3) * 360.0 - 360.0;
+        trigError(x[d], &errorSin, &errorAtan);
+    }
+    for (d = 0; d < sizeof(edges)/sizeof(edges[0]); ++d)
+        trigError(edges[d], &errorSin, &errorAtan);
+
+    printf("\n");
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = 0; d < days; ++d) {
+            sink = SIN(RAD(x[d]));
+            sink = COS(RAD(x[d]));
+            calls += 2;
+        }
+    }
+    report("SIN(RAD(x)), COS(RAD(x))", "-", now()-start, calls, 0, 0);
+
+    calls = 0;
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = 0; d < days; ++d) {
+            sink = sind(x[d]);
+            sink = cosd(x[d]);
+            calls += 2;
+        }
+    }
+    report("sind(x), cosd(x)", "-", now()-start, calls, 0, 0);
+
+    calls = 0;
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = 0; d < days; ++d) {
+            sincosd(x[d], &s, &c);
+            sink = s + c;
+            calls += 2;
+        }
+    }
+    report("sincosd(x)", "-", now()-start, calls, 0, 0);
+
+    calls = 0;
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = 0; d < days; ++d) {
+            sink = DEG(ATAN2(x[d], 100.0));
+            ++calls;
+        }
+    }
+    report("DEG(ATAN2(y,x))", "-", now()-start, calls, 0, 0);
+
+    calls = 0;
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        for (d = 0; d < days; ++d) {
+            sink = atan2d(x[d], 100.0);
+            ++calls;
+        }
+    }
+    report("atan2d(y,x)", "-", now()-start, calls, 0, 0);
+
+    printf("degree trigonometry maximum error, sin and cos %.3g, atan2 %.3g degrees\n", errorSin, errorAtan);
+
+    free(x);
+}
+
+static void tableAlloc (cartesian_table_t * table, uint32_t size)
+{
+    table->x = malloc(size * sizeof(FLOAT));
+    table->y = malloc(size * sizeof(FLOAT));
+    table->z = malloc(size * sizeof(FLOAT));
+    table->au = malloc(size * sizeof(FLOAT));
+
+    if (table->x == NULL || table->y == NULL || table->z == NULL || table->au == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+}
+
+static void tableFree (cartesian_table_t * table)
+{
+    free(table->x);
+    free(table->y);
+    free(table->z);
+    free(table->au);
+}
+
+static FLOAT tableError (const cartesian_table_t * table, uint32_t index, const cartesian_coordinates_t * location)
+{
+    FLOAT dx = table->x[index] - location->x;
+    FLOAT dy = table->y[index] - location->y;
+    FLOAT dz = table->z[index] - location->z;
+
+    return SQRT(dx*dx + dy*dy + dz*dz);
+}
+
+static void benchBatch (const simd_kernels_t * kernels)
+{
+    cartesian_table_t table;
+    cartesian_coordinates_t location;
+    FLOAT error, errorMax = 0.0, errorRelative = 0.0;
+    uint32_t iterations = 0;
+    double start;
+    uint16_t r, d;
+    uint8_t p;
+
+    if (!simdSelect(kernels))
+        return;
+
+    tableAlloc(&table, (uint32_t)PLANETS * days);
+
+    printf("\n%s kernels, %u lanes\n", kernels->name, kernels->lanes);
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        sunEclipticCartesianBatch(&table, startDay, days);
+        sink = table.x[0];
+    }
+    report("sunEclipticCartesianBatch", "Sun", now()-start, (uint32_t)repeat * days, 0, 0);
+
+    for (d = 0; d < days; ++d) {
+        location.day = startDay + d;
+        sunEclipticCartesianCoordinates(&location);
+        error = tableError(&table, d, &location);
+        if (error > errorMax)
+            errorMax = error;
+        if (error / location.au > errorRelative)
+            errorRelative = error / location.au;
+    }
+
+    for (p = 0; p < PLANETS; ++p) {                                 // lane iterations of the Kepler kernel
+        FLOAT e[BATCH_DAYS], M[BATCH_DAYS], E[BATCH_DAYS];
+        uint16_t n;
+
+        for (d = 0; d < days; d += n) {
+            n = (days - d) < BATCH_DAYS ? (days - d) : BATCH_DAYS;
+            for (r = 0; r < n; ++r) {
+                e[r] = planets[p]->e0 + ((startDay+d+r) * planets[p]->ec);
+                M[r] = rev( planets[p]->M0 + ((startDay+d+r) * planets[p]->Mc) );
+            }
+            iterations += kernels->kepler(E, e, M, n);
+        }
+    }
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        planetEclipticCartesianBatch(&table, planets, PLANETS, startDay, days);
+        sink = table.x[0];
+    }
+    report("planetEclipticCartesianBatch", "all", now()-start, (uint32_t)repeat * days * PLANETS, iterations * repeat, 0);
+
+    for (p = 0; p < PLANETS; ++p) {
+        for (d = 0; d < days; ++d) {
+            location.day = startDay + d;
+            planetEclipticCartesianCoordinates(&location, planets[p]);
+            error = tableError(&table, (uint32_t)p * days + d, &location);
+            if (error > errorMax)
+                errorMax = error;
+            if (error / location.au > errorRelative)
+                errorRelative = error / location.au;
+        }
+    }
+    printf("maximum difference from scalar functions %.3g AU, %.3g relative to radius\n", errorMax, errorRelative);
+
+    tableFree(&table);
+}
+
+int main (int argc, char ** argv)
+{
+    FLOAT errorState = 0.0;
+    uint8_t p, m;
+
+    if (argc > 1) startDay = (uint16_t)atoi(argv[1]);
+    if (argc > 2) days = (uint16_t)atoi(argv[2]);
+    if (argc > 3) repeat = (uint16_t)atoi(argv[3]);
+
+    if (days == 0 || repeat == 0 || (uint32_t)startDay + days > UINT16_MAX) {
+        fprintf(stderr, "usage: %s [start_day] [days] [repeat]\n", argv[0]);
+        return 1;
+    }
+
+    printf("days %u to %u, repeated %u times", startDay, startDay+days-1, repeat);
+#ifdef PLANET_MOTION_DEGREES
+    printf(", with degree trigonometry");
+#endif
+    printf("\n\n");
+    printf("%-40s %-8s %9s %10s %12s %9s %8s\n", "function", "body", "calls", "ns/call", "calls/sec", "iter/call", "iter max");
+
+    benchSun();
+
+    for (p = 0; p < PLANETS; ++p)
+        benchPlanet(planets[p]);
+
+    for (p = 0; p < PLANETS; ++p) {
+        FLOAT error = benchState(planets[p]);
+        if (error > errorState)
+            errorState = error;
+    }
+    printf("planet state maximum difference %.3g AU, with tolerance %g degrees\n\n", errorState, PLANET_STATE_TOLERANCE);
+
+    errorState = benchStepper(NULL);
+    for (p = 0; p < PLANETS; ++p) {
+        FLOAT error = benchStepper(planets[p]);
+        if (error > errorState)
+            errorState = error;
+    }
+    printf("stepper maximum difference %.3g AU, with direct evaluation every %u steps\n\n", errorState, STEPPER_RENORMALISE);
+
+    benchSky();
+
+    for (p = 0; p < PLANETS; ++p)
+        benchEccentricAnomaly(planets[p]);
+    printf("\n");
+
+    for (m = 0; m < KEPLER_SOLVERS; ++m) {
+        double error, errorMax = 0.0;
+
+        for (p = 0; p < PLANETS; ++p) {
+            error = benchKepler(planets[p], m);
+            if (error > errorMax)
+                errorMax = error;
+        }
+        printf("keplerSolve %s maximum error %.3g degrees, with tolerance %g degrees\n\n", keplerSolverNames[m], errorMax, KEPLER_TOLERANCE);
+    }
+
+    benchAddCartesianCoordinates();
+    benchRev();
+
+    benchTrig();
+
+    benchBatch(&simdScalar);
+#if defined(__x86_64__)
+    benchBatch(&simdSSE2);
+    benchBatch(&simdAVX2);
+#endif
+
+    return 0;
+}
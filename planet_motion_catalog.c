@@ -0,0 +1,392 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "planet_motion.h"
+#include "planet_motion_batch.h"
+#include "planet_motion_simd.h"
+#include "planet_motion_pool.h"
+#include "planet_motion_catalog.h"
+
+#define CATALOG_GROW        4096                                    // bodies added to the capacity at least
+#define CATALOG_LINE_MAX    512
+#define CATALOG_BATCH       BATCH_DAYS                              // bodies through each stage of the batch
+
+#if defined(__MATH_MATH32) || defined(__MATH_AM9511)
+    #define REV(x)  rev(x)
+#else
+    #define REV(x)  ((x) - FLOOR((x)*(FLOAT)(1/360.0))*(FLOAT)360.0)
+#endif
+
+void catalogInit ( catalog_t * catalog )
+{
+    memset(catalog, 0, sizeof(catalog_t));
+}
+
+void catalogFree ( catalog_t * catalog )
+{
+    uint8_t k;
+
+    free(catalog->name);
+    for (k = 0; k < CATALOG_ELEMENTS; ++k)
+        free(catalog->element[k]);
+    catalogInit(catalog);
+}
+
+static uint8_t reserve (catalog_t * catalog, uint32_t count)
+{
+    uint32_t capacity;
+    void * p;
+    uint8_t k;
+
+    if (count <= catalog->capacity)
+        return 1;
+
+    capacity = catalog->capacity + catalog->capacity / 2;
+    if (capacity < count)
+        capacity = count;
+    if (capacity < CATALOG_GROW)
+        capacity = CATALOG_GROW;
+
+    if ((p = realloc(catalog->name, (size_t)capacity * CATALOG_NAME_MAX)) == NULL)
+        return 0;
+    catalog->name = p;
+    for (k = 0; k < CATALOG_ELEMENTS; ++k) {
+        if ((p = realloc(catalog->element[k], (size_t)capacity * sizeof(FLOAT))) == NULL)
+            return 0;
+        catalog->element[k] = p;
+    }
+    catalog->capacity = capacity;
+    return 1;
+}
+
+uint8_t catalogAdd ( catalog_t * catalog, const char * name, const planet_t * planet )
+{
+    FLOAT ** element = catalog->element;
+    uint32_t k = catalog->count;
+
+    if (!reserve(catalog, k + 1))
+        return 0;
+
+    strncpy(catalog->name[k], name, CATALOG_NAME_MAX - 1);
+    catalog->name[k][CATALOG_NAME_MAX - 1] = '\0';
+
+    element[CATALOG_N0][k] = planet->N0;
+    element[CATALOG_NC][k] = planet->Nc;
+    element[CATALOG_I0][k] = planet->i0;
+    element[CATALOG_IC][k] = planet->ic;
+    element[CATALOG_W0][k] = planet->w0;
+    element[CATALOG_WC][k] = planet->wc;
+    element[CATALOG_A0][k] = planet->a0;
+    element[CATALOG_AC][k] = planet->ac;
+    element[CATALOG_E0][k] = planet->e0;
+    element[CATALOG_EC][k] = planet->ec;
+    element[CATALOG_M0][k] = planet->M0;
+    element[CATALOG_MC][k] = planet->Mc;
+
+    ++catalog->count;
+    return 1;
+}
+
+void catalogPlanet ( const catalog_t * catalog, uint32_t k, planet_t * planet )
+{
+    FLOAT * const * element = catalog->element;
+
+    planet->name = (char *)catalog->name[k];
+    planet->N0 = element[CATALOG_N0][k];
+    planet->Nc = element[CATALOG_NC][k];
+    planet->i0 = element[CATALOG_I0][k];
+    planet->ic = element[CATALOG_IC][k];
+    planet->w0 = element[CATALOG_W0][k];
+    planet->wc = element[CATALOG_WC][k];
+    planet->a0 = element[CATALOG_A0][k];
+    planet->ac = element[CATALOG_AC][k];
+    planet->e0 = element[CATALOG_E0][k];
+    planet->ec = element[CATALOG_EC][k];
+    planet->M0 = element[CATALOG_M0][k];
+    planet->Mc = element[CATALOG_MC][k];
+    planet->radius = 0.0;
+}
+
+// MPC text
+
+// the number in columns [first, last] of an MPCORB.DAT line, counted from 1
+static double field (const char * line, uint8_t first, uint8_t last)
+{
+    char text[16];
+    uint8_t n = last - first + 1;
+
+    memcpy(text, line + first - 1, n);
+    text[n] = '\0';
+    return strtod(text, NULL);
+}
+
+static int8_t unpack (char c)
+{
+    if (c >= '1' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'V') return c - 'A' + 10;
+    return -1;
+}
+
+// the day number (of planet_t, 0.0 at 2000 Jan 0.0) of a packed MPC epoch, as K24AH for 2024 October 17
+static uint8_t epochDay (const char * packed, double * day)
+{
+    int32_t y, m, d;
+
+    if (packed[0] < 'I' || packed[0] > 'L' || packed[1] < '0' || packed[1] > '9' || packed[2] < '0' || packed[2] > '9')
+        return 0;
+
+    y = (packed[0] - 'A' + 10) * 100 + (packed[1] - '0') * 10 + (packed[2] - '0');
+    m = unpack(packed[3]);
+    d = unpack(packed[4]);
+    if (m < 1 || m > 12 || d < 1)
+        return 0;
+
+    *day = 367 * y - 7 * (y + (m + 9) / 12) / 4 + 275 * m / 9 + d - 730530;
+    return 1;
+}
+
+int catalogReadMPC ( catalog_t * catalog, FILE * file )
+{
+    char line[CATALOG_LINE_MAX];
+    char name[CATALOG_NAME_MAX];
+    planet_t planet;
+    double epoch, M, n;
+    uint32_t count = catalog->count;                                // the bodies already loaded, kept past a header
+    uint32_t rejected = catalog->rejected;
+    uint8_t k;
+
+    memset(&planet, 0, sizeof(planet));
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strncmp(line, "-----", 5) == 0) {                       // the end of a header, drop what was taken for bodies
+            catalog->count = count;
+            catalog->rejected = rejected;
+            continue;
+        }
+        if (strlen(line) < 103 || line[0] == ' ' || line[0] == '\n' || !epochDay(line + 20, &epoch)) {
+            if (line[0] != '\n' && line[0] != '\r')
+                ++catalog->rejected;
+            continue;
+        }
+
+        planet.e0 = field(line, 71, 79);
+        planet.a0 = field(line, 93, 103);
+        n = field(line, 81, 91);
+        if (planet.e0 >= 1.0 || planet.a0 <= 0.0 || n <= 0.0) {
+            ++catalog->rejected;
+            continue;
+        }
+
+        M = field(line, 27, 35);
+        planet.M0 = REV((FLOAT)fmod(M - n * epoch, 360.0));         // back to day 0, in double
+        planet.Mc = n;
+        planet.w0 = field(line, 38, 46);
+        planet.N0 = field(line, 49, 57);
+        planet.i0 = field(line, 60, 68);
+
+        for (k = 0; k < CATALOG_NAME_MAX - 1 && line[k] != ' '; ++k)
+            name[k] = line[k];
+        name[k] = '\0';
+
+        if (!catalogAdd(catalog, name, &planet))
+            return CATALOG_ERROR_MEMORY;
+    }
+    return ferror(file) ? CATALOG_ERROR_FILE : CATALOG_OK;
+}
+
+// binary
+
+static int readBinary (catalog_t * catalog, FILE * file, const catalog_header_t * h)
+{
+    uint32_t first = catalog->count;
+    uint8_t k;
+
+    if (h->version != CATALOG_VERSION)
+        return CATALOG_ERROR_VERSION;
+    if (h->endian != CATALOG_ENDIAN)
+        return CATALOG_ERROR_ENDIAN;
+    if (h->floatSize != sizeof(FLOAT))
+        return CATALOG_ERROR_FLOAT;
+    if (h->count > UINT32_MAX - first)                              // more bodies than a catalog can count
+        return CATALOG_ERROR_FORMAT;
+    if (!reserve(catalog, first + h->count))
+        return CATALOG_ERROR_MEMORY;
+
+    if (fread(catalog->name + first, CATALOG_NAME_MAX, h->count, file) != h->count)
+        return CATALOG_ERROR_FORMAT;
+    for (k = 0; k < CATALOG_ELEMENTS; ++k)
+        if (fread(catalog->element[k] + first, sizeof(FLOAT), h->count, file) != h->count)
+            return CATALOG_ERROR_FORMAT;
+
+    catalog->count += h->count;
+    catalog->rejected += h->rejected;
+    return CATALOG_OK;
+}
+
+int catalogRead ( catalog_t * catalog, const char * filename )
+{
+    FILE * file = fopen(filename, "rb");
+    catalog_header_t h;
+    int status;
+
+    if (file == NULL)
+        return CATALOG_ERROR_FILE;
+
+    if (fread(&h, sizeof(h), 1, file) == 1 && memcmp(h.magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC)) == 0) {
+        status = readBinary(catalog, file, &h);
+    } else {
+        rewind(file);
+        status = catalogReadMPC(catalog, file);
+    }
+    fclose(file);
+    return status;
+}
+
+int catalogWrite ( const catalog_t * catalog, const char * filename )
+{
+    FILE * file = fopen(filename, "wb");
+    catalog_header_t h;
+    int status = CATALOG_OK;
+    uint8_t k;
+
+    if (file == NULL)
+        return CATALOG_ERROR_FILE;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC));
+    h.endian = CATALOG_ENDIAN;
+    h.version = CATALOG_VERSION;
+    h.floatSize = sizeof(FLOAT);
+    h.count = catalog->count;
+    h.rejected = catalog->rejected;
+
+    if (fwrite(&h, sizeof(h), 1, file) != 1 || fwrite(catalog->name, CATALOG_NAME_MAX, catalog->count, file) != catalog->count)
+        status = CATALOG_ERROR_FILE;
+    for (k = 0; k < CATALOG_ELEMENTS && status == CATALOG_OK; ++k)
+        if (fwrite(catalog->element[k], sizeof(FLOAT), catalog->count, file) != catalog->count)
+            status = CATALOG_ERROR_FILE;
+    if (fclose(file) != 0)
+        status = CATALOG_ERROR_FILE;
+    return status;
+}
+
+const char * catalogErrorString ( int error )
+{
+    switch (error) {
+        case CATALOG_OK:            return "no error";
+        case CATALOG_ERROR_FILE:    return strerror(errno);
+        case CATALOG_ERROR_FORMAT:  return "not a catalog file, or truncated";
+        case CATALOG_ERROR_VERSION: return "unsupported catalog version";
+        case CATALOG_ERROR_ENDIAN:  return "catalog written with the other byte order";
+        case CATALOG_ERROR_FLOAT:   return "catalog written with another FLOAT size";
+        case CATALOG_ERROR_MEMORY:  return "out of memory";
+        default:                    return "unknown error";
+    }
+}
+
+// propagation, as planetEclipticCartesianBatch() with the bodies in place of the days
+
+void catalogEclipticCartesianBatch ( cartesian_table_t * table, const catalog_t * catalog, uint32_t first, uint32_t count, FLOAT day )
+{
+    const simd_kernels_t * kernels = simdKernels();
+    FLOAT N[CATALOG_BATCH], i[CATALOG_BATCH], w[CATALOG_BATCH], a[CATALOG_BATCH], e[CATALOG_BATCH], M[CATALOG_BATCH], E[CATALOG_BATCH];
+    FLOAT cosE[CATALOG_BATCH], sinE[CATALOG_BATCH], xv[CATALOG_BATCH], yv[CATALOG_BATCH];
+    FLOAT cosN[CATALOG_BATCH], sinN[CATALOG_BATCH], cosi[CATALOG_BATCH], sini[CATALOG_BATCH], cosw[CATALOG_BATCH], sinw[CATALOG_BATCH];
+    FLOAT * const * element = catalog->element;
+    uint32_t start, b;
+    uint16_t k, n;
+
+    for (start = 0; start < count; start += n) {
+        FLOAT * x = table->x + start;
+        FLOAT * y = table->y + start;
+        FLOAT * z = table->z + start;
+        FLOAT * au = table->au + start;
+
+        b = first + start;
+        n = (count - start) < CATALOG_BATCH ? (uint16_t)(count - start) : CATALOG_BATCH;
+
+        for (k = 0; k < n; ++k) {                                   // orbital elements of each body
+            N[k] = element[CATALOG_N0][b+k] + (day * element[CATALOG_NC][b+k]);
+            i[k] = element[CATALOG_I0][b+k] + (day * element[CATALOG_IC][b+k]);
+            w[k] = element[CATALOG_W0][b+k] + (day * element[CATALOG_WC][b+k]);
+            a[k] = element[CATALOG_A0][b+k] + (day * element[CATALOG_AC][b+k]);
+            e[k] = element[CATALOG_E0][b+k] + (day * element[CATALOG_EC][b+k]);
+            M[k] = element[CATALOG_M0][b+k] + (day * element[CATALOG_MC][b+k]);
+        }
+
+        for (k = 0; k < n; ++k) {
+            N[k] = REV(N[k]);
+            i[k] = REV(i[k]);
+            w[k] = REV(w[k]);
+            M[k] = REV(M[k]);
+        }
+
+        kernels->kepler(E, e, M, n);
+        kernels->sincosd(sinE, cosE, E, n);
+
+        for (k = 0; k < n; ++k) {                                   // position in the orbital plane
+            xv[k] = a[k] * (cosE[k] - e[k]);
+            yv[k] = a[k] * SQRT(1 - e[k] * e[k]) * sinE[k];
+        }
+
+        for (k = 0; k < n; ++k) {                                   // distance from the Sun in AU
+            au[k] = SQRT(xv[k] * xv[k] + yv[k] * yv[k]);
+        }
+
+        kernels->sincosd(sinN, cosN, N, n);
+        kernels->sincosd(sini, cosi, i, n);
+        kernels->sincosd(sinw, cosw, w, n);
+
+        for (k = 0; k < n; ++k) {
+            FLOAT rcosVW = xv[k] * cosw[k] - yv[k] * sinw[k];
+            FLOAT rsinVW = yv[k] * cosw[k] + xv[k] * sinw[k];
+
+            x[k] = cosN[k] * rcosVW - sinN[k] * rsinVW * cosi[k];
+            y[k] = sinN[k] * rcosVW + cosN[k] * rsinVW * cosi[k];
+            z[k] = rsinVW * sini[k];
+        }
+    }
+}
+
+typedef struct propagate_s {
+    cartesian_table_t * table;
+    const catalog_t * catalog;
+    FLOAT day;
+} propagate_t;
+
+static pool_t pool;
+
+static void run (void * context, uint32_t task, uint32_t slot, uint16_t worker)
+{
+    propagate_t * propagate = context;
+    uint32_t first = task * CATALOG_TASK_BODIES;
+    uint32_t count = propagate->catalog->count - first;
+    cartesian_table_t rows = { propagate->table->x + first, propagate->table->y + first, propagate->table->z + first, propagate->table->au + first };
+
+    (void)slot;
+    (void)worker;
+    catalogEclipticCartesianBatch(&rows, propagate->catalog, first, count < CATALOG_TASK_BODIES ? count : CATALOG_TASK_BODIES, propagate->day);
+}
+
+static void emit (void * context, uint32_t task, uint32_t slot)
+{
+    (void)context;                                                  // the rows are written in place
+    (void)task;
+    (void)slot;
+}
+
+uint8_t catalogPropagate ( cartesian_table_t * table, const catalog_t * catalog, FLOAT day, uint16_t threads )
+{
+    propagate_t propagate = { table, catalog, day };
+    uint32_t tasks = (catalog->count + CATALOG_TASK_BODIES - 1) / CATALOG_TASK_BODIES;
+
+    if (tasks == 0)
+        return 1;
+    return poolRun(&pool, threads, tasks, tasks, run, emit, &propagate);
+}
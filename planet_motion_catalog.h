@@ -0,0 +1,131 @@
+/*
+ * planet_motion_catalog.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_CATALOG_H
+#define _PLANET_MOTION_CATALOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host catalog of many small bodies, as structure of arrays of the planet_t elements.
+//
+// Read from the MPC's MPCORB.DAT text format, or from the binary format written by catalogWrite(),
+// which is a header followed by the designations and then each element array in turn, in the byte
+// order of the writer, given by the endian tag, with IEEE FLOAT.
+//
+// The MPC osculating elements are held fixed at their epoch, except the mean anomaly, which moves
+// at the mean daily motion. Only elliptic orbits (e < 1) are kept.
+
+#define CATALOG_MAGIC       "PMCATLG"
+#define CATALOG_VERSION     1
+#define CATALOG_ENDIAN      0x01020304
+#define CATALOG_NAME_MAX    8               // the packed MPC designation, and a NUL
+
+#define CATALOG_TASK_BODIES 4096            // bodies per task of catalogPropagate()
+
+// element arrays, in the order of planet_t
+
+#define CATALOG_N0          0
+#define CATALOG_NC          1
+#define CATALOG_I0          2
+#define CATALOG_IC          3
+#define CATALOG_W0          4
+#define CATALOG_WC          5
+#define CATALOG_A0          6
+#define CATALOG_AC          7
+#define CATALOG_E0          8
+#define CATALOG_EC          9
+#define CATALOG_M0          10
+#define CATALOG_MC          11
+
+#define CATALOG_ELEMENTS    12
+
+// errors
+
+#define CATALOG_OK              0
+#define CATALOG_ERROR_FILE      -1      // see errno.
+#define CATALOG_ERROR_FORMAT    -2      // not a catalog, or truncated.
+#define CATALOG_ERROR_VERSION   -3
+#define CATALOG_ERROR_ENDIAN    -4      // written with the other byte order.
+#define CATALOG_ERROR_FLOAT     -5      // written with another FLOAT size.
+#define CATALOG_ERROR_MEMORY    -6
+
+// type definitions
+
+typedef struct catalog_header_s {   // the start of a binary catalog
+    char magic[8];
+    uint32_t endian;        // CATALOG_ENDIAN, as written.
+    uint16_t version;
+    uint8_t floatSize;      // sizeof(FLOAT).
+    uint8_t reserved;
+    uint32_t count;
+    uint32_t rejected;      // lines of the source that were not elliptic orbits, or could not be read.
+} catalog_header_t;
+
+typedef struct catalog_s {
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t rejected;      // lines read that were not elliptic orbits, or could not be read.
+    char (* name)[CATALOG_NAME_MAX];
+    FLOAT * element[CATALOG_ELEMENTS];  // each of count bodies.
+} catalog_t;
+
+// catalog functions (C)
+
+void catalogInit ( catalog_t * catalog );
+void catalogFree ( catalog_t * catalog );
+
+// Add a body with the elements of planet, returning 0 when out of memory.
+uint8_t catalogAdd ( catalog_t * catalog, const char * name, const planet_t * planet );
+
+// The elements of body k as a planet_t, named by the catalog.
+void catalogPlanet ( const catalog_t * catalog, uint32_t k, planet_t * planet );
+
+// Add the bodies of MPCORB.DAT text, skipping any header down to its line of dashes.
+int catalogReadMPC ( catalog_t * catalog, FILE * file );
+
+// Add the bodies of a binary catalog, or of MPC text when the file is not one.
+int catalogRead ( catalog_t * catalog, const char * filename );
+int catalogWrite ( const catalog_t * catalog, const char * filename );
+const char * catalogErrorString ( int error );
+
+// propagation functions (C)
+
+// As planetEclipticCartesianBatch(), for the bodies [first, first+count) on day, body k into row k - first.
+void catalogEclipticCartesianBatch ( cartesian_table_t * table, const catalog_t * catalog, uint32_t first, uint32_t count, FLOAT day );
+
+// Every body of the catalog on day, into rows of table, in tasks of CATALOG_TASK_BODIES on threads.
+// Returns 0 if the threads could not be had.
+uint8_t catalogPropagate ( cartesian_table_t * table, const catalog_t * catalog, FLOAT day, uint16_t threads );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_CATALOG_H  */
@@ -0,0 +1,260 @@
+/*
+ * planet_motion_catalog_bench.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host benchmark of loading and propagating a catalog of many small bodies.
+
+    build and run with:
+
+    make
+    ./planet_motion_catalog_bench [-t threads] [-n count] [-i catalog] [-o binary] [start_day] [days]
+
+    The catalog is read from the MPCORB.DAT text or binary file given by -i, or otherwise count main
+    belt asteroids are made up and written as MPCORB.DAT text, which is then read from memory.
+    Both reads are timed, in bodies per second, and with -o the catalog is written in the binary
+    format and read back again, timed.
+
+    A sample of the bodies is checked against planetEclipticCartesianCoordinates(), and then the
+    whole catalog is propagated for each of days days with 1, 2, 4 ... up to threads threads,
+    reporting bodies per second. The threads can only help where there are cores to run them.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "planet_motion.h"
+#include "planet_motion_batch.h"
+#include "planet_motion_pool.h"
+#include "planet_motion_catalog.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                32
+#define COUNT               100000
+#define THREADS             4
+#define SAMPLE              997                                     // check every SAMPLE'th body
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+static uint32_t count = COUNT;
+static uint16_t threads = THREADS;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+static double uniform (double lo, double hi)
+{
+    return lo + (hi - lo) * (rand() / (RAND_MAX + 1.0));
+}
+
+// count made up main belt asteroids, as MPCORB.DAT lines with the epoch 2024 October 17
+static void synthesise (FILE * file, uint32_t count)
+{
+    char name[16];
+    uint32_t k;
+    double a;
+
+    fprintf(file, "Made up main belt asteroids, in the columns of MPCORB.DAT\n\n");
+    fprintf(file, "Des'n     H     G   Epoch     M        Peri.      Node       Incl.       e            n           a\n");
+    fprintf(file, "----------------------------------------------------------------------------------------------------\n");
+
+    srand(1);
+    for (k = 0; k < count; ++k) {
+        snprintf(name, sizeof(name), "%07u", k + 1);
+        a = uniform(2.1, 3.3);
+        fprintf(file, "%-7s %5.2f %5.2f %-5s %9.5f  %9.5f  %9.5f  %9.5f  %9.7f %11.8f %11.7f\n",
+                name, uniform(10.0, 18.0), 0.15, "K24AH",
+                uniform(0.0, 360.0), uniform(0.0, 360.0), uniform(0.0, 360.0), uniform(0.0, 30.0),
+                uniform(0.0, 0.3), 0.9856076686 / pow(a, 1.5), a);
+    }
+}
+
+static void report (const char * what, uint32_t bodies, double seconds)
+{
+    printf("%-24s %8u bodies %9.3f ms %12.0f bodies/s\n", what, bodies, seconds * 1.0e3, bodies / seconds);
+}
+
+int main (int argc, char ** argv)
+{
+    const char * input = NULL;
+    const char * output = NULL;
+    catalog_t catalog;
+    cartesian_table_t table;
+    cartesian_coordinates_t location;
+    planet_t planet;
+    double t, worst = 0.0;
+    uint32_t k;
+    uint16_t d, n;
+    int status, opt;
+
+    while ((opt = getopt(argc, argv, "t:n:i:o:")) != -1) {
+        switch (opt) {
+            case 't': threads = (uint16_t)atoi(optarg); break;
+            case 'n': count = (uint32_t)atol(optarg); break;
+            case 'i': input = optarg; break;
+            case 'o': output = optarg; break;
+            default: threads = 0; break;
+        }
+    }
+    if (optind < argc) startDay = (uint16_t)atoi(argv[optind]);
+    if (optind + 1 < argc) days = (uint16_t)atoi(argv[optind + 1]);
+    if (threads == 0 || threads > POOL_WORKERS_MAX || count == 0 || days == 0) {
+        fprintf(stderr, "usage: %s [-t threads] [-n count] [-i catalog] [-o binary] [start_day] [days]\n", argv[0]);
+        return 1;
+    }
+
+    catalogInit(&catalog);
+
+    if (input != NULL) {
+        t = now();
+        status = catalogRead(&catalog, input);
+        t = now() - t;
+        if (status != CATALOG_OK) {
+            fprintf(stderr, "%s: %s\n", input, catalogErrorString(status));
+            return 1;
+        }
+        report("read", catalog.count, t);
+    } else {
+        char * text = NULL;
+        size_t size = 0;
+        FILE * file = open_memstream(&text, &size);
+
+        if (file == NULL) {
+            perror("open_memstream");
+            return 1;
+        }
+        synthesise(file, count);
+        fclose(file);
+
+        file = fmemopen(text, size, "r");
+        t = now();
+        status = catalogReadMPC(&catalog, file);
+        t = now() - t;
+        fclose(file);
+        free(text);
+        if (status != CATALOG_OK) {
+            fprintf(stderr, "MPC text: %s\n", catalogErrorString(status));
+            return 1;
+        }
+        report("read MPC text", catalog.count, t);
+    }
+    if (catalog.rejected)
+        printf("%u lines rejected\n", catalog.rejected);
+
+    if (output != NULL) {
+        catalog_t binary;
+
+        t = now();
+        status = catalogWrite(&catalog, output);
+        t = now() - t;
+        if (status != CATALOG_OK) {
+            fprintf(stderr, "%s: %s\n", output, catalogErrorString(status));
+            return 1;
+        }
+        report("write binary", catalog.count, t);
+
+        catalogInit(&binary);
+        t = now();
+        status = catalogRead(&binary, output);
+        t = now() - t;
+        if (status != CATALOG_OK || binary.count != catalog.count ||
+            memcmp(binary.element[CATALOG_M0], catalog.element[CATALOG_M0], catalog.count * sizeof(FLOAT)) != 0) {
+            fprintf(stderr, "%s: %s, or not as written\n", output, catalogErrorString(status));
+            return 1;
+        }
+        report("read binary", binary.count, t);
+        catalogFree(&binary);
+    }
+
+    if (catalog.count == 0) {
+        fprintf(stderr, "no bodies\n");
+        return 1;
+    }
+
+    table.x = malloc(catalog.count * sizeof(FLOAT));
+    table.y = malloc(catalog.count * sizeof(FLOAT));
+    table.z = malloc(catalog.count * sizeof(FLOAT));
+    table.au = malloc(catalog.count * sizeof(FLOAT));
+    if (table.x == NULL || table.y == NULL || table.z == NULL || table.au == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // check a sample against the scalar path
+    if (!catalogPropagate(&table, &catalog, (FLOAT)startDay, 1)) {
+        fprintf(stderr, "no threads\n");
+        return 1;
+    }
+    for (k = 0; k < catalog.count; k += SAMPLE) {
+        catalogPlanet(&catalog, k, &planet);
+        location.day = (FLOAT)startDay;
+        planetEclipticCartesianCoordinates(&location, &planet);
+        t = sqrt(SQR(location.x - table.x[k]) + SQR(location.y - table.y[k]) + SQR(location.z - table.z[k]));
+        if (t > worst)
+            worst = t;
+    }
+    printf("\n%u bodies checked, largest difference %.2e AU\n\n", (catalog.count + SAMPLE - 1) / SAMPLE, worst);
+
+    for (n = 1; ; n *= 2) {
+        char what[32];
+
+        if (n > threads)
+            n = threads;
+
+        t = now();
+        for (d = 0; d < days; ++d) {
+            if (!catalogPropagate(&table, &catalog, (FLOAT)(startDay + d), n)) {
+                fprintf(stderr, "no threads\n");
+                return 1;
+            }
+        }
+        t = now() - t;
+
+        snprintf(what, sizeof(what), "propagate %u thread%s", n, n > 1 ? "s" : "");
+        report(what, catalog.count, t / days);
+        if (n == threads)
+            break;
+    }
+    printf("\n%ld cores online\n", sysconf(_SC_NPROCESSORS_ONLN));
+
+    free(table.x);
+    free(table.y);
+    free(table.z);
+    free(table.au);
+    catalogFree(&catalog);
+    return 0;
+}
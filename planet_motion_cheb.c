@@ -0,0 +1,49 @@
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_cheb.h"
+
+// sum of the Chebyshev series c[0..order) at x, by Clenshaw's recurrence
+static FLOAT clenshaw (const FLOAT * c, uint8_t order, FLOAT x)
+{
+    FLOAT x2 = 2.0 * x;
+    FLOAT b1 = 0.0;
+    FLOAT b2 = 0.0;
+    FLOAT b;
+
+    while (--order) {
+        b = c[order] + x2 * b1 - b2;
+        b2 = b1;
+        b1 = b;
+    }
+    return c[0] + x * b1 - b2;
+}
+
+uint8_t chebEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const cheb_table_t * table, uint8_t body ) __z88dk_callee
+{
+    const cheb_body_t * b = &table->body[body];
+    const FLOAT * c;
+    FLOAT t, x;
+    uint16_t segment;
+
+    t = location->day - table->start;
+    if (t < 0.0 || t > table->days)
+        return 0;
+
+    t /= b->span;
+    segment = (uint16_t)t;
+    if (segment >= b->segments)                                     // the last day of the table
+        segment = b->segments - 1;
+
+    x = 2.0 * (t - segment) - 1.0;                                  // position in the segment, -1 to 1
+    c = &b->coefficients[(uint32_t)segment * 4 * b->order];
+
+    location->x = clenshaw(c, b->order, x);
+    location->y = clenshaw(c + b->order, b->order, x);
+    location->z = clenshaw(c + 2 * b->order, b->order, x);
+    location->au = clenshaw(c + 3 * b->order, b->order, x);
+    return 1;
+}
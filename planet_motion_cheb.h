@@ -0,0 +1,82 @@
+/*
+ * planet_motion_cheb.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_CHEB_H
+#define _PLANET_MOTION_CHEB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// most coefficients per coordinate of a segment, and the segment lengths tried by the fit (days)
+
+#define CHEB_ORDER_MAX  16
+#define CHEB_SPAN_MIN   1
+#define CHEB_SPAN_MAX   4096
+
+// type definitions
+
+typedef struct cheb_body_s {        // piecewise Chebyshev series of a body's ecliptic coordinates
+    const char * name;
+    FLOAT span;             // days per segment.
+    uint16_t segments;      // segments covering the table days.
+    uint8_t order;          // coefficients per coordinate.
+    const FLOAT * coefficients; // x, y, z and au series of each segment in turn, [segment][4][order].
+} cheb_body_t;
+
+typedef struct cheb_table_s {       // bodies fitted over the days [start, start+days]
+    FLOAT start;
+    FLOAT days;
+    uint8_t bodies;
+    const cheb_body_t * body;
+} cheb_table_t;
+
+// Chebyshev evaluator (C)
+
+// As planetEclipticCartesianCoordinates(), for the body of table at location->day.
+// A segment lookup and a Clenshaw sum per coordinate, with no trigonometry or Kepler solve.
+// Returns 0, leaving location unchanged, when the day is outside the table.
+uint8_t chebEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const cheb_table_t * table, uint8_t body ) __z88dk_callee;
+
+// Chebyshev generator (host C, planet_motion_cheb_fit.c)
+
+// Fit the planet, or the Sun (seen from Earth) when planet is NULL, over the days [start, start+days],
+// choosing the segment span and order that need the fewest coefficients for tolerance (AU).
+// The coefficients are allocated, to be released with chebFree().
+// Returns the error bound of the fit, which is above tolerance when it can't be met.
+double chebFit ( cheb_body_t * body, const planet_t * planet, FLOAT start, FLOAT days, double tolerance );
+void chebFree ( cheb_body_t * body );
+
+// Write the table as C source, defining const cheb_table_t name.
+void chebWriteSource ( FILE * file, const cheb_table_t * table, const char * name );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_CHEB_H  */
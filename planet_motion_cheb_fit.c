@@ -0,0 +1,225 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_cheb.h"
+
+// Each segment is fitted by least squares with CHEB_FIT_ORDER coefficients, from samples at the
+// Chebyshev points. The samples are taken at the FLOAT days nearest those points, and fitted at
+// the days actually used, as the rounding of a day near 10000 is up to 5e-4 days.
+//
+// The coefficients beyond CHEB_ORDER_MAX give an estimate of the truncation error,
+// and the order of a segment is the fewest coefficients whose dropped tail is within tolerance.
+
+#define CHEB_FIT_ORDER  (CHEB_ORDER_MAX+4)
+#define CHEB_SAMPLES    (2*CHEB_FIT_ORDER)
+
+static void sample (cartesian_coordinates_t * location, const planet_t * planet, FLOAT day)
+{
+    location->day = day;
+
+    if (planet == NULL)
+        sunEclipticCartesianCoordinates(location);
+    else
+        planetEclipticCartesianCoordinates(location, planet);
+}
+
+// least squares Chebyshev series of x, y, z and au over the days [begin, begin+span]
+static void fitSegment (double c[4][CHEB_FIT_ORDER], const planet_t * planet, double begin, double span)
+{
+    double normal[CHEB_FIT_ORDER][CHEB_FIT_ORDER] = {{0.0}};
+    double rhs[4][CHEB_FIT_ORDER] = {{0.0}};
+    double T[CHEB_FIT_ORDER];
+    cartesian_coordinates_t location;
+    uint8_t j, k, l, q;
+
+    for (j = 0; j < CHEB_SAMPLES; ++j) {
+        double x = cos(M_PI * (j + 0.5) / CHEB_SAMPLES);
+        FLOAT day = (FLOAT)(begin + (x + 1.0) * span * 0.5);
+        double f[4];
+
+        sample(&location, planet, day);
+        f[0] = location.x;
+        f[1] = location.y;
+        f[2] = location.z;
+        f[3] = location.au;
+
+        x = 2.0 * ((double)day - begin) / span - 1.0;               // the point actually sampled
+        T[0] = 1.0;
+        T[1] = x;
+        for (k = 2; k < CHEB_FIT_ORDER; ++k)
+            T[k] = 2.0 * x * T[k-1] - T[k-2];
+
+        for (k = 0; k < CHEB_FIT_ORDER; ++k) {
+            for (l = 0; l <= k; ++l)
+                normal[k][l] += T[k] * T[l];
+            for (q = 0; q < 4; ++q)
+                rhs[q][k] += T[k] * f[q];
+        }
+    }
+
+    // Cholesky factor of the normal equations, in the lower triangle
+    for (k = 0; k < CHEB_FIT_ORDER; ++k) {
+        for (l = 0; l < k; ++l)
+            normal[k][k] -= normal[k][l] * normal[k][l];
+        normal[k][k] = sqrt(normal[k][k]);
+
+        for (j = k+1; j < CHEB_FIT_ORDER; ++j) {
+            for (l = 0; l < k; ++l)
+                normal[j][k] -= normal[j][l] * normal[k][l];
+            normal[j][k] /= normal[k][k];
+        }
+    }
+
+    for (q = 0; q < 4; ++q) {
+        for (k = 0; k < CHEB_FIT_ORDER; ++k) {                      // forward substitution
+            double s = rhs[q][k];
+            for (l = 0; l < k; ++l)
+                s -= normal[k][l] * c[q][l];
+            c[q][k] = s / normal[k][k];
+        }
+        for (k = CHEB_FIT_ORDER; k-- > 0; ) {                       // back substitution
+            double s = c[q][k];
+            for (l = k+1; l < CHEB_FIT_ORDER; ++l)
+                s -= normal[l][k] * c[q][l];
+            c[q][k] = s / normal[k][k];
+        }
+    }
+}
+
+// largest over the coordinates of the coefficients dropped when truncating to order
+static double tail (double c[4][CHEB_FIT_ORDER], uint8_t order)
+{
+    double bound = 0.0;
+    uint8_t k, q;
+
+    for (q = 0; q < 4; ++q) {
+        double s = 0.0;
+        for (k = order; k < CHEB_FIT_ORDER; ++k)
+            s += fabs(c[q][k]);
+        if (s > bound)
+            bound = s;
+    }
+    return bound;
+}
+
+double chebFit ( cheb_body_t * body, const planet_t * planet, FLOAT start, FLOAT days, double tolerance )
+{
+    double c[4][CHEB_FIT_ORDER];
+    double bestBound = HUGE_VAL;
+    uint32_t bestSize = UINT32_MAX;
+    uint32_t span, bestSpan = CHEB_SPAN_MIN;
+    uint8_t bestOrder = CHEB_ORDER_MAX;
+    FLOAT * coefficients;
+    uint32_t segment, segments;
+    uint8_t k, q;
+
+    for (span = CHEB_SPAN_MIN; span <= CHEB_SPAN_MAX; span *= 2) {
+        double bounds[CHEB_ORDER_MAX+1] = {0.0};                    // largest dropped tail over the segments, per order
+        double bound;
+        uint8_t order, met;
+
+        segments = (uint32_t)ceil(days / span);
+        if (segments == 0)
+            segments = 1;
+        if (segments > UINT16_MAX)
+            continue;
+
+        for (segment = 0; segment < segments; ++segment) {
+            fitSegment(c, planet, start + (double)segment * span, span);
+            for (order = 1; order <= CHEB_ORDER_MAX; ++order) {
+                bound = tail(c, order);
+                if (bound > bounds[order])
+                    bounds[order] = bound;
+            }
+        }
+
+        for (order = 1; order < CHEB_ORDER_MAX && bounds[order] > tolerance; ++order)
+            ;
+        bound = bounds[order];
+        met = bound <= tolerance;
+
+        if ((met && segments * order < bestSize) || (!met && bestSize == UINT32_MAX && bound < bestBound)) {
+            if (met)
+                bestSize = segments * order;
+            bestBound = bound;
+            bestSpan = span;
+            bestOrder = order;
+        }
+        if (segments == 1)                                          // longer spans only fit more days than needed
+            break;
+    }
+
+    segments = (uint32_t)ceil(days / bestSpan);
+    if (segments == 0)
+        segments = 1;
+
+    coefficients = malloc(segments * 4 * bestOrder * sizeof(FLOAT));
+    if (coefficients == NULL)
+        return HUGE_VAL;
+
+    for (segment = 0; segment < segments; ++segment) {
+        fitSegment(c, planet, start + (double)segment * bestSpan, bestSpan);
+        for (q = 0; q < 4; ++q)
+            for (k = 0; k < bestOrder; ++k)
+                coefficients[(segment * 4 + q) * bestOrder + k] = (FLOAT)c[q][k];
+    }
+
+    body->name = planet ? planet->name : "Sun";
+    body->span = bestSpan;
+    body->segments = (uint16_t)segments;
+    body->order = bestOrder;
+    body->coefficients = coefficients;
+
+    return bestBound;
+}
+
+void chebFree ( cheb_body_t * body )
+{
+    free((void *)body->coefficients);
+    body->coefficients = NULL;
+    body->segments = 0;
+}
+
+static void identifier (char * id, const char * prefix, const char * name)
+{
+    id += sprintf(id, "%s_", prefix);
+    for ( ; *name; ++name)
+        *id++ = isalnum((unsigned char)*name) ? tolower((unsigned char)*name) : '_';
+    *id = '\0';
+}
+
+void chebWriteSource ( FILE * file, const cheb_table_t * table, const char * name )
+{
+    char id[64];
+    uint32_t k, count;
+    uint8_t b;
+
+    fprintf(file, "\n// Chebyshev ephemeris of days %.1f to %.1f, generated by planet_motion_cheb_gen.\n\n", (double)table->start, (double)(table->start + table->days));
+    fprintf(file, "#include <stdint.h>\n#include <stdio.h>\n#include <math.h>\n\n#include \"planet_motion.h\"\n#include \"planet_motion_cheb.h\"\n");
+
+    for (b = 0; b < table->bodies; ++b) {
+        const cheb_body_t * body = &table->body[b];
+
+        identifier(id, name, body->name);
+        count = (uint32_t)body->segments * 4 * body->order;
+
+        fprintf(file, "\nstatic const FLOAT %s[] = {       // %u segments of %g days, order %u\n", id, body->segments, (double)body->span, body->order);
+        for (k = 0; k < count; ++k)
+            fprintf(file, "%s%.9g,%s", (k % body->order) ? " " : "    ", (double)body->coefficients[k], ((k+1) % body->order) ? "" : "\n");
+        fprintf(file, "};\n");
+    }
+
+    fprintf(file, "\nstatic const cheb_body_t %s_body[] = {\n", name);
+    for (b = 0; b < table->bodies; ++b) {
+        const cheb_body_t * body = &table->body[b];
+
+        identifier(id, name, body->name);
+        fprintf(file, "    { \"%s\", %.1f, %u, %u, %s },\n", body->name, (double)body->span, body->segments, body->order, id);
+    }
+    fprintf(file, "};\n\nconst cheb_table_t %s = { %.1f, %.1f, %u, %s_body };\n", name, (double)table->start, (double)table->days, table->bodies, name);
+}
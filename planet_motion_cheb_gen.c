@@ -0,0 +1,207 @@
+/*
+ * planet_motion_cheb_gen.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Chebyshev ephemeris generator, and its cost and size report.
+
+    build with:
+
+    make
+
+    planet_motion_cheb_gen [start_day] [days] [tolerance [table.c]]
+
+    The Sun and the planets are fitted over the days [start_day, start_day+days].
+    With no tolerance each of the levels 1e-2 to 1e-6 AU is reported, otherwise that
+    tolerance is reported, and the table is written as C source to table.c if given.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_cheb.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                3653                                    // 10 years
+#define BODIES              PLANETS                                 // the Sun, then the planets after sun
+#define SAMPLES_PER_DAY     4                                       // days checked against the direct functions
+
+volatile FLOAT sink;                                                // defeat dead code elimination
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+// body b of the table, NULL for the Sun
+static const planet_t * bodyPlanet (uint8_t b)
+{
+    return b ? planets[b] : NULL;
+}
+
+static void direct (cartesian_coordinates_t * location, uint8_t b)
+{
+    if (b == 0)
+        sunEclipticCartesianCoordinates(location);
+    else
+        planetEclipticCartesianCoordinates(location, planets[b]);
+}
+
+static double directNs (uint8_t b)
+{
+    cartesian_coordinates_t location;
+    uint32_t k, samples = (uint32_t)days * SAMPLES_PER_DAY;
+    double start = now();
+
+    for (k = 0; k < samples; ++k) {
+        location.day = startDay + (FLOAT)k / SAMPLES_PER_DAY;
+        direct(&location, b);
+        sink = location.x;
+    }
+    return (now() - start) / samples;
+}
+
+static void report (const cheb_table_t * table, double tolerance, double fitNs)
+{
+    cartesian_coordinates_t location, reference;
+    uint32_t k, samples = (uint32_t)days * SAMPLES_PER_DAY;
+    uint32_t bytes, bytesAll = sizeof(cheb_table_t);
+    double ns, nsAll = 0.0;
+    double error, errorMax, errorAll = 0.0;
+    uint8_t b;
+
+    printf("tolerance %g AU, fitted in %.2f s\n", tolerance, fitNs * 1.0e-9);
+    printf("%-8s %6s %6s %9s %9s %9s %9s %13s\n", "body", "span", "order", "segments", "bytes", "mul/eval", "ns/eval", "max error AU");
+
+    for (b = 0; b < table->bodies; ++b) {
+        const cheb_body_t * body = &table->body[b];
+        double start = now();
+
+        for (k = 0; k < samples; ++k) {
+            location.day = startDay + (FLOAT)k / SAMPLES_PER_DAY;
+            chebEclipticCartesianCoordinates(&location, table, b);
+            sink = location.x;
+        }
+        ns = (now() - start) / samples;
+
+        errorMax = 0.0;
+        for (k = 0; k < samples; ++k) {
+            location.day = reference.day = startDay + (FLOAT)k / SAMPLES_PER_DAY;
+            chebEclipticCartesianCoordinates(&location, table, b);
+            direct(&reference, b);
+            error = sqrt(SQR((double)location.x - reference.x) + SQR((double)location.y - reference.y) + SQR((double)location.z - reference.z));
+            if (error > errorMax)
+                errorMax = error;
+        }
+
+        bytes = (uint32_t)body->segments * 4 * body->order * sizeof(FLOAT) + sizeof(cheb_body_t);
+        bytesAll += bytes;
+        nsAll += ns;
+        if (errorMax > errorAll)
+            errorAll = errorMax;
+
+        printf("%-8s %6.0f %6u %9u %9u %9u %9.1f %13.3g\n", body->name, (double)body->span, body->order, body->segments,
+                bytes, 4 * (2 * body->order - 1), ns, errorMax);
+    }
+    printf("%-8s %6s %6s %9s %9u %9s %9.1f %13.3g\n\n", "all", "", "", "", bytesAll, "", nsAll / table->bodies, errorAll);
+}
+
+static int generate (double tolerance, const char * filename)
+{
+    cheb_body_t body[BODIES];
+    cheb_table_t table = { startDay, days, BODIES, body };
+    double start, bound;
+    uint8_t b;
+    int status = 0;
+
+    start = now();
+    for (b = 0; b < BODIES; ++b) {
+        bound = chebFit(&body[b], bodyPlanet(b), startDay, days, tolerance);
+        if (bound == HUGE_VAL) {
+            fprintf(stderr, "out of memory fitting %s\n", planets[b]->name);
+            while (b--)
+                chebFree(&body[b]);
+            return 1;
+        }
+        if (bound > tolerance)
+            printf("%s: tolerance not met, error bound %.3g AU\n", body[b].name, bound);
+    }
+    report(&table, tolerance, now() - start);
+
+    if (filename != NULL) {
+        FILE * file = fopen(filename, "w");
+
+        if (file == NULL) {
+            perror(filename);
+            status = 1;
+        } else {
+            chebWriteSource(file, &table, "chebTable");
+            fclose(file);
+        }
+    }
+
+    for (b = 0; b < BODIES; ++b)
+        chebFree(&body[b]);
+    return status;
+}
+
+int main (int argc, char ** argv)
+{
+    double tolerance;
+    uint8_t b;
+
+    if (argc > 1) startDay = (uint16_t)atoi(argv[1]);
+    if (argc > 2) days = (uint16_t)atoi(argv[2]);
+
+    if (days == 0 || (uint32_t)startDay + days > UINT16_MAX || (argc > 3 && atof(argv[3]) <= 0.0)) {
+        fprintf(stderr, "usage: %s [start_day] [days] [tolerance [table.c]]\n", argv[0]);
+        return 1;
+    }
+
+    printf("days %u to %u, %u bytes per coefficient\n\n", startDay, startDay+days, (unsigned)sizeof(FLOAT));
+    printf("%-8s %9s\n", "body", "ns/call");
+    for (b = 0; b < BODIES; ++b)
+        printf("%-8s %9.1f\n", b ? planets[b]->name : "Sun", directNs(b));
+    printf("\n");
+
+    if (argc > 3)
+        return generate(atof(argv[3]), argc > 4 ? argv[4] : NULL);
+
+    for (tolerance = 1.0e-2; tolerance > 0.5e-6; tolerance *= 0.1)
+        if (generate(tolerance, NULL))
+            return 1;
+    return 0;
+}
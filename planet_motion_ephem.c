@@ -0,0 +1,295 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "planet_motion.h"
+#include "planet_motion_batch.h"
+#include "planet_motion_cheb.h"
+#include "planet_motion_ephem.h"
+
+_Static_assert(sizeof(ephem_header_t) == EPHEM_ALIGN, "ephem_header_t is one EPHEM_ALIGN block");
+_Static_assert(sizeof(ephem_body_t) == EPHEM_ALIGN, "ephem_body_t is one EPHEM_ALIGN block");
+
+#define EPHEM_BATCH_DAYS    4096                                    // days per call of the batch functions
+
+static uint64_t align (uint64_t bytes)
+{
+    return (bytes + (EPHEM_ALIGN-1)) & ~(uint64_t)(EPHEM_ALIGN-1);
+}
+
+static void header (ephem_header_t * h, uint8_t kind, double start, double days, uint32_t bodies)
+{
+    memset(h, 0, sizeof(ephem_header_t));
+    memcpy(h->magic, EPHEM_MAGIC, sizeof(EPHEM_MAGIC));
+    h->endian = EPHEM_ENDIAN;
+    h->version = EPHEM_VERSION;
+    h->kind = kind;
+    h->floatSize = sizeof(FLOAT);
+    h->start = start;
+    h->days = days;
+    h->bodies = bodies;
+}
+
+static int writeFile (const char * filename, const uint8_t * data, uint64_t size)
+{
+    FILE * file = fopen(filename, "wb");
+    int status = EPHEM_OK;
+
+    if (file == NULL)
+        return EPHEM_ERROR_FILE;
+    if (fwrite(data, 1, size, file) != size)
+        status = EPHEM_ERROR_FILE;
+    if (fclose(file) != 0)
+        status = EPHEM_ERROR_FILE;
+    return status;
+}
+
+int ephemWriteSamples ( const char * filename, FLOAT start, uint32_t days )
+{
+    ephem_header_t * h;
+    ephem_body_t * entry;
+    uint8_t * data;
+    uint64_t size, offset;
+    uint32_t stride, day;
+    uint8_t b;
+    int status;
+
+    stride = (uint32_t)(align((uint64_t)days * sizeof(FLOAT)) / sizeof(FLOAT));
+    offset = align(sizeof(ephem_header_t) + PLANETS * sizeof(ephem_body_t));
+    size = offset + (uint64_t)PLANETS * 4 * stride * sizeof(FLOAT);
+
+    data = calloc(1, size);
+    if (data == NULL)
+        return EPHEM_ERROR_FILE;
+
+    h = (ephem_header_t *)data;
+    header(h, EPHEM_SAMPLES, start, days, PLANETS);
+    h->step = 1.0;
+    h->samples = days;
+    h->size = size;
+
+    entry = (ephem_body_t *)(data + sizeof(ephem_header_t));
+    for (b = 0; b < PLANETS; ++b, offset += 4 * stride * sizeof(FLOAT)) {
+        const planet_t * planet = planets[b];
+        FLOAT * x = (FLOAT *)(data + offset);
+
+        strncpy(entry[b].name, b ? planet->name : "Sun", sizeof(entry[b].name) - 1);
+        entry[b].offset = offset;
+        entry[b].stride = stride;
+
+        for (day = 0; day < days; day += EPHEM_BATCH_DAYS) {
+            uint16_t count = (days - day < EPHEM_BATCH_DAYS) ? (uint16_t)(days - day) : EPHEM_BATCH_DAYS;
+            cartesian_table_t table = { &x[day], &x[stride + day], &x[2*stride + day], &x[3*stride + day] };
+
+            if (b == 0)                                             // the Sun, then the planets after sun
+                sunEclipticCartesianBatch(&table, start + day, count);
+            else
+                planetEclipticCartesianBatch(&table, &planet, 1, start + day, count);
+        }
+    }
+
+    status = writeFile(filename, data, size);
+    free(data);
+    return status;
+}
+
+int ephemWriteChebyshev ( const char * filename, const cheb_table_t * table )
+{
+    ephem_header_t * h;
+    ephem_body_t * entry;
+    uint8_t * data;
+    uint64_t size, offset, bytes;
+    uint8_t b;
+    int status;
+
+    if (table->bodies > EPHEM_BODIES_MAX)
+        return EPHEM_ERROR_FORMAT;
+
+    offset = align(sizeof(ephem_header_t) + table->bodies * sizeof(ephem_body_t));
+    size = offset;
+    for (b = 0; b < table->bodies; ++b)
+        size += align((uint64_t)table->body[b].segments * 4 * table->body[b].order * sizeof(FLOAT));
+
+    data = calloc(1, size);
+    if (data == NULL)
+        return EPHEM_ERROR_FILE;
+
+    h = (ephem_header_t *)data;
+    header(h, EPHEM_CHEBYSHEV, table->start, table->days, table->bodies);
+    h->size = size;
+
+    entry = (ephem_body_t *)(data + sizeof(ephem_header_t));
+    for (b = 0; b < table->bodies; ++b, offset += align(bytes)) {
+        const cheb_body_t * body = &table->body[b];
+
+        bytes = (uint64_t)body->segments * 4 * body->order * sizeof(FLOAT);
+        strncpy(entry[b].name, body->name, sizeof(entry[b].name) - 1);
+        entry[b].offset = offset;
+        entry[b].segments = body->segments;
+        entry[b].span = body->span;
+        entry[b].order = body->order;
+        memcpy(data + offset, body->coefficients, bytes);
+    }
+
+    status = writeFile(filename, data, size);
+    free(data);
+    return status;
+}
+
+// check the header and directory, so that no later access can fall outside the map
+static int validate (const uint8_t * map, size_t size)
+{
+    const ephem_header_t * h = (const ephem_header_t *)map;
+    const ephem_body_t * entry = (const ephem_body_t *)(map + sizeof(ephem_header_t));
+    uint64_t bytes;
+    uint32_t b;
+
+    if (size < sizeof(ephem_header_t) || memcmp(h->magic, EPHEM_MAGIC, sizeof(EPHEM_MAGIC)) != 0)
+        return EPHEM_ERROR_FORMAT;
+    if (h->endian != EPHEM_ENDIAN)
+        return (h->endian == __builtin_bswap32(EPHEM_ENDIAN)) ? EPHEM_ERROR_ENDIAN : EPHEM_ERROR_FORMAT;
+    if (h->version != EPHEM_VERSION)
+        return EPHEM_ERROR_VERSION;
+    if (h->floatSize != sizeof(FLOAT))
+        return EPHEM_ERROR_FLOAT;
+    if (h->size != size || h->bodies > EPHEM_BODIES_MAX || h->kind > EPHEM_CHEBYSHEV ||
+            size < sizeof(ephem_header_t) + h->bodies * sizeof(ephem_body_t))
+        return EPHEM_ERROR_FORMAT;
+
+    for (b = 0; b < h->bodies; ++b) {
+        if (memchr(entry[b].name, '\0', sizeof(entry[b].name)) == NULL)
+            return EPHEM_ERROR_FORMAT;
+        if (h->kind == EPHEM_SAMPLES) {
+            if (entry[b].stride < h->samples)
+                return EPHEM_ERROR_FORMAT;
+            bytes = (uint64_t)4 * entry[b].stride * sizeof(FLOAT);
+        } else {
+            if (entry[b].order == 0 || entry[b].order > UINT8_MAX || entry[b].segments == 0 || entry[b].segments > UINT16_MAX || !(entry[b].span > 0.0) ||
+                    !(entry[b].span * entry[b].segments >= h->days))
+                return EPHEM_ERROR_FORMAT;
+            bytes = (uint64_t)entry[b].segments * 4 * entry[b].order * sizeof(FLOAT);
+        }
+        if (entry[b].offset % EPHEM_ALIGN || entry[b].offset > size || bytes > size - entry[b].offset)
+            return EPHEM_ERROR_FORMAT;
+    }
+    return EPHEM_OK;
+}
+
+int ephemOpen ( ephem_t * ephem, const char * filename )
+{
+    struct stat st;
+    void * map;
+    uint32_t b;
+    int fd, status;
+
+    memset(ephem, 0, sizeof(ephem_t));
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return EPHEM_ERROR_FILE;
+
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return EPHEM_ERROR_FILE;
+    }
+    if ((size_t)st.st_size < sizeof(ephem_header_t)) {
+        close(fd);
+        return EPHEM_ERROR_FORMAT;
+    }
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);     // shared with every other reader through the page cache
+    close(fd);
+    if (map == MAP_FAILED)
+        return EPHEM_ERROR_FILE;
+
+    status = validate(map, st.st_size);
+    if (status != EPHEM_OK) {
+        munmap(map, st.st_size);
+        return status;
+    }
+
+    ephem->map = map;
+    ephem->size = st.st_size;
+    ephem->header = (const ephem_header_t *)map;
+    ephem->body = (const ephem_body_t *)(ephem->map + sizeof(ephem_header_t));
+
+    if (ephem->header->kind == EPHEM_CHEBYSHEV) {
+        for (b = 0; b < ephem->header->bodies; ++b) {
+            ephem->cheb[b].name = ephem->body[b].name;
+            ephem->cheb[b].span = ephem->body[b].span;
+            ephem->cheb[b].segments = ephem->body[b].segments;
+            ephem->cheb[b].order = ephem->body[b].order;
+            ephem->cheb[b].coefficients = (const FLOAT *)(ephem->map + ephem->body[b].offset);
+        }
+        ephem->table.start = ephem->header->start;
+        ephem->table.days = ephem->header->days;
+        ephem->table.bodies = ephem->header->bodies;
+        ephem->table.body = ephem->cheb;
+    }
+    return EPHEM_OK;
+}
+
+void ephemClose ( ephem_t * ephem )
+{
+    if (ephem->map != NULL)
+        munmap((void *)ephem->map, ephem->size);
+    memset(ephem, 0, sizeof(ephem_t));
+}
+
+const char * ephemErrorString ( int error )
+{
+    switch (error) {
+        case EPHEM_OK:              return "no error";
+        case EPHEM_ERROR_FILE:      return strerror(errno);
+        case EPHEM_ERROR_FORMAT:    return "not an ephemeris file, or truncated";
+        case EPHEM_ERROR_VERSION:   return "unsupported ephemeris version";
+        case EPHEM_ERROR_ENDIAN:    return "ephemeris written with the other byte order";
+        case EPHEM_ERROR_FLOAT:     return "ephemeris written with another FLOAT size";
+        default:                    return "unknown error";
+    }
+}
+
+const FLOAT * ephemSamples ( const ephem_t * ephem, uint8_t body, uint8_t coordinate )
+{
+    if (ephem->header->kind != EPHEM_SAMPLES || body >= ephem->header->bodies || coordinate > 3)
+        return NULL;
+
+    return (const FLOAT *)(ephem->map + ephem->body[body].offset) + (size_t)coordinate * ephem->body[body].stride;
+}
+
+uint8_t ephemEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const ephem_t * ephem, uint8_t body )
+{
+    const ephem_header_t * h = ephem->header;
+    const FLOAT * x;
+    double t;
+    uint32_t k, stride;
+
+    if (body >= h->bodies)
+        return 0;
+
+    if (h->kind == EPHEM_CHEBYSHEV)
+        return chebEclipticCartesianCoordinates(location, &ephem->table, body);
+
+    t = (location->day - h->start) / h->step;
+    if (t < 0.0 || t >= h->samples || t != floor(t))                // only the days sampled
+        return 0;
+
+    k = (uint32_t)t;
+    stride = ephem->body[body].stride;
+    x = (const FLOAT *)(ephem->map + ephem->body[body].offset);
+
+    location->x = x[k];
+    location->y = x[stride + k];
+    location->z = x[2*stride + k];
+    location->au = x[3*stride + k];
+    return 1;
+}
@@ -0,0 +1,124 @@
+/*
+ * planet_motion_ephem.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_EPHEM_H
+#define _PLANET_MOTION_EPHEM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Binary ephemeris file (host, POSIX mmap)
+//
+// A header, a directory of bodies, then the data of each body starting on an EPHEM_ALIGN boundary.
+// Sampled files hold x, y, z and au arrays per body, each padded to EPHEM_ALIGN bytes.
+// Chebyshev files hold the coefficients of each body as cheb_body_t, [segment][4][order].
+// All fields are in the byte order of the writer, given by the endian tag, and FLOAT is IEEE.
+
+#define EPHEM_MAGIC         "PMEPHEM"
+#define EPHEM_VERSION       1
+#define EPHEM_ENDIAN        0x01020304
+#define EPHEM_ALIGN         64
+#define EPHEM_BODIES_MAX    16
+
+#define EPHEM_SAMPLES       0
+#define EPHEM_CHEBYSHEV     1
+
+// errors
+
+#define EPHEM_OK            0
+#define EPHEM_ERROR_FILE    -1      // see errno.
+#define EPHEM_ERROR_FORMAT  -2      // not an ephemeris, or truncated.
+#define EPHEM_ERROR_VERSION -3
+#define EPHEM_ERROR_ENDIAN  -4      // written with the other byte order.
+#define EPHEM_ERROR_FLOAT   -5      // written with another FLOAT size.
+
+// type definitions
+
+typedef struct ephem_header_s {     // the first EPHEM_ALIGN bytes of the file
+    char magic[8];
+    uint32_t endian;        // EPHEM_ENDIAN, as written.
+    uint16_t version;
+    uint8_t kind;           // EPHEM_SAMPLES or EPHEM_CHEBYSHEV.
+    uint8_t floatSize;      // sizeof(FLOAT).
+    double start;           // first day.
+    double days;            // days covered.
+    double step;            // days between samples.
+    uint32_t samples;       // samples per body.
+    uint32_t bodies;
+    uint64_t size;          // bytes in the file.
+    uint8_t reserved[8];
+} ephem_header_t;
+
+typedef struct ephem_body_s {       // directory entry of each body, following the header
+    char name[16];
+    uint64_t offset;        // bytes from the start of the file to the body's data.
+    uint32_t stride;        // FLOATs from each sampled array to the next.
+    uint32_t segments;      // Chebyshev segments, span and order, as cheb_body_t.
+    double span;
+    uint32_t order;
+    uint8_t reserved[20];
+} ephem_body_t;
+
+typedef struct ephem_s {            // an ephemeris file mapped for reading
+    const uint8_t * map;
+    size_t size;
+    const ephem_header_t * header;
+    const ephem_body_t * body;
+    cheb_body_t cheb[EPHEM_BODIES_MAX];   // Chebyshev bodies, with coefficients in the map.
+    cheb_table_t table;
+} ephem_t;
+
+// ephemeris writer functions (C)
+
+// Sample the Sun and planets, as planet_motion_cheb_gen, for each day of [start, start+days).
+int ephemWriteSamples ( const char * filename, FLOAT start, uint32_t days );
+
+// Write a Chebyshev table.
+int ephemWriteChebyshev ( const char * filename, const cheb_table_t * table );
+
+// ephemeris reader functions (C)
+
+// Map the file, checking the header and directory. The data is read in place, and never copied.
+int ephemOpen ( ephem_t * ephem, const char * filename );
+void ephemClose ( ephem_t * ephem );
+const char * ephemErrorString ( int error );
+
+// The x, y, z or au array (coordinate 0 to 3) of a body of a sampled file, aligned to EPHEM_ALIGN.
+// Returns NULL for a Chebyshev file.
+const FLOAT * ephemSamples ( const ephem_t * ephem, uint8_t body, uint8_t coordinate );
+
+// As planetEclipticCartesianCoordinates(), for a body at location->day.
+// Sampled files only answer the days sampled. Returns 0, leaving location unchanged, for other days.
+uint8_t ephemEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const ephem_t * ephem, uint8_t body );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_EPHEM_H  */
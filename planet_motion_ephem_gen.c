@@ -0,0 +1,155 @@
+/*
+ * planet_motion_ephem_gen.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Binary ephemeris writer, and its reader report.
+
+    build with:
+
+    make
+
+    planet_motion_ephem_gen file [start_day] [days] [tolerance]
+
+    The Sun and the planets are written to file for the days [start_day, start_day+days),
+    sampled daily, or as Chebyshev series when a tolerance (AU) is given.
+    The file is then mapped, and the open time, lookup time and difference from the
+    direct functions are reported.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_cheb.h"
+#include "planet_motion_ephem.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                36525                                   // 100 years
+
+volatile FLOAT sink;                                                // defeat dead code elimination
+
+static uint32_t startDay = START_DAY;
+static uint32_t days = DAYS;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static int writeChebyshev (const char * filename, double tolerance)
+{
+    cheb_body_t body[PLANETS];
+    cheb_table_t table = { startDay, days, PLANETS, body };
+    int status = EPHEM_OK;
+    uint8_t b;
+
+    for (b = 0; b < PLANETS; ++b) {
+        if (chebFit(&body[b], b ? planets[b] : NULL, startDay, days, tolerance) == HUGE_VAL) {
+            status = EPHEM_ERROR_FILE;
+            break;
+        }
+    }
+    if (status == EPHEM_OK)
+        status = ephemWriteChebyshev(filename, &table);
+
+    while (b--)
+        chebFree(&body[b]);
+    return status;
+}
+
+int main (int argc, char ** argv)
+{
+    ephem_t ephem;
+    cartesian_coordinates_t location, reference;
+    double start, tolerance = 0.0;
+    double error, errorMax = 0.0;
+    uint32_t d, lookups = 0;
+    uint8_t b;
+    int status;
+
+    if (argc > 2) startDay = (uint32_t)atoi(argv[2]);
+    if (argc > 3) days = (uint32_t)atoi(argv[3]);
+    if (argc > 4) tolerance = atof(argv[4]);
+
+    if (argc < 2 || days == 0 || startDay + days > UINT16_MAX || (argc > 4 && tolerance <= 0.0)) {
+        fprintf(stderr, "usage: %s file [start_day] [days] [tolerance]\n", argv[0]);
+        return 1;
+    }
+
+    start = now();
+    status = (tolerance > 0.0) ? writeChebyshev(argv[1], tolerance) : ephemWriteSamples(argv[1], startDay, days);
+    if (status != EPHEM_OK) {
+        fprintf(stderr, "%s: %s\n", argv[1], ephemErrorString(status));
+        return 1;
+    }
+    printf("wrote days %u to %u", startDay, startDay+days-1);
+    if (tolerance > 0.0)
+        printf(" as Chebyshev series within %g AU", tolerance);
+    printf(" in %.2f s\n", (now()-start) * 1.0e-9);
+
+    start = now();
+    status = ephemOpen(&ephem, argv[1]);
+    if (status != EPHEM_OK) {
+        fprintf(stderr, "%s: %s\n", argv[1], ephemErrorString(status));
+        return 1;
+    }
+    printf("opened %zu bytes in %.1f us\n", ephem.size, (now()-start) * 1.0e-3);
+
+    start = now();
+    for (b = 0; b < ephem.header->bodies; ++b) {
+        for (d = startDay; d < startDay+days; ++d) {
+            location.day = d;
+            lookups += ephemEclipticCartesianCoordinates(&location, &ephem, b);
+            sink = location.x;
+        }
+    }
+    printf("%u lookups at %.1f ns/lookup\n", lookups, (now()-start) / lookups);
+
+    for (b = 0; b < ephem.header->bodies; ++b) {
+        for (d = startDay; d < startDay+days; ++d) {
+            location.day = reference.day = d;
+            ephemEclipticCartesianCoordinates(&location, &ephem, b);
+            if (b == 0)
+                sunEclipticCartesianCoordinates(&reference);
+            else
+                planetEclipticCartesianCoordinates(&reference, planets[b]);
+            error = sqrt(SQR((double)location.x - reference.x) + SQR((double)location.y - reference.y) + SQR((double)location.z - reference.z));
+            if (error > errorMax)
+                errorMax = error;
+        }
+    }
+    printf("maximum difference from the direct functions %.3g AU\n", errorMax);
+
+    ephemClose(&ephem);
+    return 0;
+}
@@ -0,0 +1,261 @@
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_hermite.h"
+#include "planet_motion_event.h"
+
+// Each body is solved with its elements brought up to the whole day in double, leaving only the
+// fraction of the day to FLOAT, so a minute is resolved for any day of the centuries searched.
+// The Earth is placed by the elements sun, rather than sunEclipticCartesianCoordinates(), so that
+// it can be brought up to the day the same way.
+//
+// Conjunctions and oppositions are the roots of the difference in geocentric ecliptic longitude,
+// less 180 degrees for oppositions, wrapped into [-180, 180), bracketed where the sign changes
+// between coarse steps by less than half a turn. Approaches are the roots of the rate of change of
+// the cosine of the separation, from the velocities, bracketed where the cosine stops increasing.
+
+#define EVENT_ITERATIONS_MAX    64
+
+typedef struct geocentric_s {
+    cartesian_coordinates_t a, b;   // geocentric position and velocity of each body.
+    cartesian_coordinates_t va, vb;
+} geocentric_t;
+
+static uint8_t orbitsEarth (const planet_t * planet)
+{
+    return planet == &sun || planet == &moon;
+}
+
+// the elements of planet, moved on by day
+static void rebase (planet_t * p, const planet_t * planet, double day)
+{
+    *p = *planet;
+    p->N0 = fmod(planet->N0 + (double)planet->Nc * day, 360.0);
+    p->i0 = fmod(planet->i0 + (double)planet->ic * day, 360.0);
+    p->w0 = fmod(planet->w0 + (double)planet->wc * day, 360.0);
+    p->a0 = planet->a0 + (double)planet->ac * day;
+    p->e0 = planet->e0 + (double)planet->ec * day;
+    p->M0 = fmod(planet->M0 + (double)planet->Mc * day, 360.0);
+}
+
+// planet in its own orbit, and its velocity when asked for
+static void solve (cartesian_coordinates_t * location, cartesian_coordinates_t * velocity, const planet_t * planet, double day, uint32_t * evaluations)
+{
+    double whole = floor(day);
+    planet_t p;
+
+    rebase(&p, planet, whole);
+    location->day = (FLOAT)(day - whole);
+    if (velocity)
+        planetEclipticCartesianVelocity(location, velocity, &p);
+    else
+        planetEclipticCartesianCoordinates(location, &p);
+    ++*evaluations;
+}
+
+static void add (cartesian_coordinates_t * base, const cartesian_coordinates_t * addend)
+{
+    base->x += addend->x;
+    base->y += addend->y;
+    base->z += addend->z;
+}
+
+// a and b seen from the Earth, with their velocities for approaches
+static void geocentric (geocentric_t * g, event_search_t * search, double day)
+{
+    uint8_t velocities = (search->type == EVENT_APPROACH);
+    cartesian_coordinates_t s, vs;
+
+    if (!orbitsEarth(search->a) || !orbitsEarth(search->b) || search->a == &sun || search->b == &sun)
+        solve(&s, velocities ? &vs : NULL, &sun, day, &search->evaluations);
+
+    if (search->a == &sun) {
+        g->a = s;
+        g->va = vs;
+    } else {
+        solve(&g->a, velocities ? &g->va : NULL, search->a, day, &search->evaluations);
+        if (!orbitsEarth(search->a)) {
+            add(&g->a, &s);
+            if (velocities)
+                add(&g->va, &vs);
+        }
+    }
+
+    if (search->b == &sun) {
+        g->b = s;
+        g->vb = vs;
+    } else {
+        solve(&g->b, velocities ? &g->vb : NULL, search->b, day, &search->evaluations);
+        if (!orbitsEarth(search->b)) {
+            add(&g->b, &s);
+            if (velocities)
+                add(&g->vb, &vs);
+        }
+    }
+}
+
+void eventGeocentricCoordinates ( cartesian_coordinates_t * location, const planet_t * planet, double day )
+{
+    cartesian_coordinates_t s;
+    uint32_t evaluations = 0;
+
+    solve(location, NULL, planet, day, &evaluations);
+    if (!orbitsEarth(planet)) {
+        solve(&s, NULL, &sun, day, &evaluations);
+        add(location, &s);
+    }
+    location->day = (FLOAT)day;
+}
+
+static double dot (const cartesian_coordinates_t * u, const cartesian_coordinates_t * v)
+{
+    return (double)u->x * v->x + (double)u->y * v->y + (double)u->z * v->z;
+}
+
+// the angle (deg) between the directions of u and v
+static double separation (const cartesian_coordinates_t * u, const cartesian_coordinates_t * v)
+{
+    double cx = (double)u->y * v->z - (double)u->z * v->y;
+    double cy = (double)u->z * v->x - (double)u->x * v->z;
+    double cz = (double)u->x * v->y - (double)u->y * v->x;
+
+    return DEG(atan2(sqrt(cx * cx + cy * cy + cz * cz), dot(u, v)));
+}
+
+// the function of day with a root at each event, and the separation (deg) of the bodies then
+static double eventFunction (event_search_t * search, double day, FLOAT * apart)
+{
+    geocentric_t g;
+    double f;
+
+    geocentric(&g, search, day);
+
+    if (search->type == EVENT_APPROACH) {
+        // d/dt (a.b)/(|a||b|), where d/dt a/|a| is (va - (va.a) a/|a|^2)/|a|
+        double aa = dot(&g.a, &g.a);
+        double bb = dot(&g.b, &g.b);
+        double ab = dot(&g.a, &g.b);
+
+        f = (dot(&g.va, &g.b) - dot(&g.va, &g.a) * ab / aa + dot(&g.a, &g.vb) - dot(&g.vb, &g.b) * ab / bb) / sqrt(aa * bb);
+        *apart = (FLOAT)separation(&g.a, &g.b);
+    } else {
+        f = atan2(g.a.y, g.a.x) - atan2(g.b.y, g.b.x);
+        f = DEG(f) - (search->type == EVENT_OPPOSITION ? 180.0 : 0.0);
+        f -= 360.0 * floor((f + 180.0) / 360.0);
+        if (search->type == EVENT_OPPOSITION) {
+            g.b.x = -g.b.x;
+            g.b.y = -g.b.y;
+            g.b.z = -g.b.z;
+        }
+        *apart = (FLOAT)separation(&g.a, &g.b);
+    }
+    return f;
+}
+
+// Brent's method, for the root of the event function between days a and b, where fa and fb differ in sign
+static double brent (event_search_t * search, double a, double b, double fa, double fb, double tolerance)
+{
+    FLOAT apart;
+    double c = a, fc = fa, d = b - a, e = d;
+    double s, p, q, r, m, tol;
+    uint8_t k;
+
+    for (k = 0; k < EVENT_ITERATIONS_MAX; ++k) {
+        if ((fb > 0.0) == (fc > 0.0)) {                             // keep the root between b and c
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (fabs(fc) < fabs(fb)) {                                  // b the best so far
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+
+        tol = 0.5 * tolerance;
+        m = 0.5 * (c - b);
+        if (fabs(m) <= tol || fb == 0.0)
+            break;
+
+        if (fabs(e) >= tol && fabs(fa) > fabs(fb)) {                // secant, or inverse quadratic interpolation
+            s = fb / fa;
+            if (a == c) {
+                p = 2.0 * m * s;
+                q = 1.0 - s;
+            } else {
+                q = fa / fc;
+                r = fb / fc;
+                p = s * (2.0 * m * q * (q - r) - (b - a) * (r - 1.0));
+                q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0)
+                q = -q;
+            p = fabs(p);
+            if (2.0 * p < fmin(3.0 * m * q - fabs(tol * q), fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {                                                // bisect
+                d = m;
+                e = d;
+            }
+        } else {
+            d = m;
+            e = d;
+        }
+
+        a = b;
+        fa = fb;
+        b += (fabs(d) > tol) ? d : (m > 0.0 ? tol : -tol);
+        fb = eventFunction(search, b, &apart);
+    }
+    return b;
+}
+
+double eventStep ( const planet_t * a, const planet_t * b )
+{
+    double rate = fabs(sun.Mc);                                     // the Earth's
+
+    if (fabs(a->Mc) > rate)
+        rate = fabs(a->Mc);
+    if (fabs(b->Mc) > rate)
+        rate = fabs(b->Mc);
+    return EVENT_STEP / rate;
+}
+
+uint16_t eventSearch ( event_search_t * search, event_t * event, uint16_t count )
+{
+    double tolerance = (search->tolerance > 0.0) ? search->tolerance : EVENT_TOLERANCE;
+    double step = search->step;
+    double t0, t1, f0, f1;
+    FLOAT apart;
+    uint16_t found = 0;
+
+    search->evaluations = 0;
+
+    if (step <= 0.0)
+        step = eventStep(search->a, search->b);
+
+    t0 = search->start;
+    f0 = eventFunction(search, t0, &apart);
+
+    while (t0 < search->end && found < count) {
+        t1 = (t0 + step < search->end) ? t0 + step : search->end;
+        f1 = eventFunction(search, t1, &apart);
+
+        if (search->type == EVENT_APPROACH ? (f0 > 0.0 && f1 <= 0.0)
+                                           : (((f0 <= 0.0 && f1 > 0.0) || (f0 >= 0.0 && f1 < 0.0)) && fabs(f1 - f0) < 180.0)) {
+            event[found].day = brent(search, t0, t1, f0, f1, tolerance);
+            event[found].type = search->type;
+            eventFunction(search, event[found].day, &apart);
+            event[found].separation = apart;
+            if (search->type != EVENT_APPROACH || apart < search->limit)
+                ++found;
+        }
+
+        t0 = t1;
+        f0 = f1;
+    }
+    return found;
+}
@@ -0,0 +1,87 @@
+/*
+ * planet_motion_event.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_EVENT_H
+#define _PLANET_MOTION_EVENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// events, as seen from the centre of the Earth
+
+#define EVENT_CONJUNCTION   0               // a and b at the same ecliptic longitude, or a behind or before the Sun when b is sun.
+#define EVENT_OPPOSITION    1               // a at the ecliptic longitude opposite b, usually sun.
+#define EVENT_APPROACH      2               // the least angular separation of a and b.
+
+// The coarse step is the days the fastest of the two bodies and the Earth take to move this far
+// along their mean orbits, well inside the time between events, even for retrograde loops.
+
+#define EVENT_STEP          20.0            // degrees
+#define EVENT_TOLERANCE     (1.0/1440.0)    // days, one minute
+
+// type definitions
+
+typedef struct event_s {
+    uint8_t type;
+    double day;             // day of the event, with its fraction.
+    FLOAT separation;       // angular separation (deg) of the bodies, or of a from opposite b.
+} event_t;
+
+typedef struct event_search_s {     // a search for the events of a pair of bodies over a range of days
+    uint8_t type;
+    const planet_t * a;
+    const planet_t * b;     // the other body, or sun.
+    double start, end;      // days searched.
+    double step;            // coarse step in days, or 0.0 to size it from the mean motions.
+    double tolerance;       // days the events are refined to, or 0.0 for EVENT_TOLERANCE.
+    FLOAT limit;            // only approaches closer than limit (deg) are events.
+    uint32_t evaluations;   // positions of a body solved by the search.
+} event_search_t;
+
+// event functions (C)
+
+// The geocentric ecliptic coordinates of planet for day, with its fraction, solved with the elements
+// of planet brought up to the whole day, so that the fraction keeps its precision over the centuries.
+// The Sun and Moon are the elements sun and moon, their geocentric orbits.
+void eventGeocentricCoordinates ( cartesian_coordinates_t * location, const planet_t * planet, double day );
+
+// The coarse step (days) for a and b, of EVENT_STEP along the fastest of their mean orbits and the Earth's.
+double eventStep ( const planet_t * a, const planet_t * b );
+
+// Find the events of search, in order of day, up to count of them. Returns the number found.
+// The range is walked in coarse steps to bracket each event, which is then refined to the tolerance,
+// by Brent's method on the difference in longitude for conjunctions and oppositions, and on the rate
+// of change of the cosine of the separation for approaches. Two events within a coarse step may be missed.
+uint16_t eventSearch ( event_search_t * search, event_t * event, uint16_t count );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_EVENT_H  */
@@ -0,0 +1,186 @@
+/*
+ * planet_motion_event_report.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host report of the event search, for conjunctions, oppositions and close approaches.
+
+    build and run with:
+
+    make
+    ./planet_motion_event_report [-l listed] [-m minutes] [start_day] [days]
+
+    Each search is run over the days from start_day, refined to minutes, listing the first listed
+    events of each in UT. Then the same search is walked a day at a time, or a tenth of the coarse
+    step for the Moon, as a scan of every day would, to check that no events were missed by the
+    coarse steps, and to compare the positions solved and the time taken. A scan to the minute,
+    without refinement, would solve 1440 times the positions of the daily scan.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_event.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                36525                                   // a century
+#define LISTED              3
+#define EVENTS_MAX          4096
+#define DENSE_STEPS         10                                      // scan steps to each coarse step, at most a day
+
+static uint16_t startDay = START_DAY;
+static uint32_t days = DAYS;
+static uint16_t listed = LISTED;
+static double minutes = 1.0;
+
+static event_t event[EVENTS_MAX];
+
+typedef struct search_s {
+    uint8_t type;
+    const planet_t * a;
+    const planet_t * b;
+    FLOAT limit;            // deg, for approaches
+} search_t;
+
+static const search_t searches[] = {
+    { EVENT_OPPOSITION,  &mars,    &sun,     0.0 },
+    { EVENT_OPPOSITION,  &jupiter, &sun,     0.0 },
+    { EVENT_OPPOSITION,  &saturn,  &sun,     0.0 },
+    { EVENT_CONJUNCTION, &mercury, &sun,     0.0 },
+    { EVENT_CONJUNCTION, &venus,   &jupiter, 0.0 },
+    { EVENT_CONJUNCTION, &jupiter, &saturn,  0.0 },
+    { EVENT_APPROACH,    &venus,   &jupiter, 1.0 },
+    { EVENT_APPROACH,    &moon,    &mars,    1.0 },
+};
+
+static const char * const names[] = { "conjunction", "opposition", "approach" };
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+// the UT date and time of a day, where day 0.0 is 2000 January 0.0, as 1999-12-31 00:00
+static void date (char * text, size_t size, double day)
+{
+    double whole = floor(day);
+    int32_t z = (int32_t)whole + 10956 + 719468;                    // days from 1970-01-01, then from 0000-03-01
+    int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int32_t doe = z - era * 146097;
+    int32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int32_t mp = (5 * doy + 2) / 153;
+    int32_t d = doy - (153 * mp + 2) / 5 + 1;
+    int32_t m = mp < 10 ? mp + 3 : mp - 9;
+    int32_t y = yoe + era * 400 + (m <= 2);
+    int32_t minute = (int32_t)floor((day - whole) * 1440.0 + 0.5);
+
+    if (minute == 1440) {                                           // rounded up to midnight
+        date(text, size, whole + 1.0);
+        return;
+    }
+    snprintf(text, size, "%04d-%02d-%02d %02d:%02d", (int)y, (int)m, (int)d, (int)(minute / 60), (int)(minute % 60));
+}
+
+int main (int argc, char ** argv)
+{
+    uint32_t total = 0, totalDense = 0;
+    double timeCoarse = 0.0, timeDense = 0.0;
+    uint8_t s, missed = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l:m:")) != -1) {
+        switch (opt) {
+            case 'l': listed = (uint16_t)atoi(optarg); break;
+            case 'm': minutes = atof(optarg); break;
+            default: minutes = 0.0; break;
+        }
+    }
+    if (optind < argc) startDay = (uint16_t)atoi(argv[optind]);
+    if (optind + 1 < argc) days = (uint32_t)atol(argv[optind + 1]);
+    if (minutes <= 0.0 || days == 0) {
+        fprintf(stderr, "usage: %s [-l listed] [-m minutes] [start_day] [days]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%u days from day %u, refined to %g minutes\n", days, startDay, minutes);
+
+    for (s = 0; s < sizeof(searches)/sizeof(searches[0]); ++s) {
+        event_search_t search;
+        uint16_t found, dense, k;
+        double t;
+        char text[48];
+
+        search.type = searches[s].type;
+        search.a = searches[s].a;
+        search.b = searches[s].b;
+        search.start = startDay;
+        search.end = (double)startDay + days;
+        search.step = 0.0;
+        search.tolerance = minutes / 1440.0;
+        search.limit = searches[s].limit;
+
+        t = now();
+        found = eventSearch(&search, event, EVENTS_MAX);
+        t = now() - t;
+        timeCoarse += t;
+        total += search.evaluations;
+
+        printf("\n%s %s %s: %u events, %u positions, %.3f ms\n", search.a->name, names[search.type], search.b->name, found, search.evaluations, t * 1.0e3);
+        for (k = 0; k < found && k < listed; ++k) {
+            date(text, sizeof(text), event[k].day);
+            printf("    %s UT  day %11.5f  %8.4f deg\n", text, event[k].day, event[k].separation);
+        }
+
+        search.step = eventStep(search.a, search.b) / DENSE_STEPS;
+        if (search.step > 1.0)
+            search.step = 1.0;
+
+        t = now();
+        dense = eventSearch(&search, event, EVENTS_MAX);
+        t = now() - t;
+        timeDense += t;
+        totalDense += search.evaluations;
+
+        printf("    dense scan: %u events, %u positions, %.3f ms\n", dense, search.evaluations, t * 1.0e3);
+        if (dense != found)
+            missed = 1;
+    }
+
+    printf("\n%u positions in %.3f ms, against %u in %.3f ms for the dense scan, %.1f times fewer\n",
+            total, timeCoarse * 1.0e3, totalDense, timeDense * 1.0e3, (double)totalDense / total);
+    if (missed)
+        printf("the coarse steps and the dense scan found different events\n");
+    return missed;
+}
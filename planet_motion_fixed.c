@@ -0,0 +1,315 @@
+
+#include <stdint.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+#include "planet_motion_fixed.h"
+
+#define KEPLER_TOLERANCE_BAM    ((int32_t)(KEPLER_TOLERANCE*BAM_PER_DEGREE))
+#define RAD_TO_BAM              20861       // 2^32/(2*PI) as Q28 to binary angles, in Q13
+
+// the Sun, as sunEclipticCartesianCoordinates() at T = 0
+
+#define SUN_L0      ((bam_t)((280.46645 - 1.5*36000.76983/36525.0)*BAM_PER_DEGREE))
+#define SUN_LC      ((int32_t)(36000.76983/36525.0*BAM_PER_DEGREE))
+#define SUN_M0      ((bam_t)((357.52910 - 1.5*35999.05030/36525.0)*BAM_PER_DEGREE))
+#define SUN_MC      ((int32_t)(35999.05030/36525.0*BAM_PER_DEGREE))
+#define SUN_C1      ((int32_t)(1.914600*BAM_PER_DEGREE))
+#define SUN_C2      ((int32_t)(0.01993*BAM_PER_DEGREE))
+#define SUN_C3      ((int32_t)(0.000290*BAM_PER_DEGREE))
+#define SUN_E       ((int16_t)(0.016708617*FIXED_UNIT + 0.5))
+#define SUN_R       ((fixed_t)(1.000001018*(1.0 - 0.016708617*0.016708617)*FIXED_ONE))
+
+// sin(x) for a quarter wave, in 256 steps, Q2.14
+
+static const int16_t sine[257] = {
+        0,   101,   201,   302,   402,   503,   603,   704,   804,   904,  1005,  1105,
+     1205,  1306,  1406,  1506,  1606,  1706,  1806,  1906,  2006,  2105,  2205,  2305,
+     2404,  2503,  2603,  2702,  2801,  2900,  2999,  3098,  3196,  3295,  3393,  3492,
+     3590,  3688,  3786,  3883,  3981,  4078,  4176,  4273,  4370,  4467,  4563,  4660,
+     4756,  4852,  4948,  5044,  5139,  5235,  5330,  5425,  5520,  5614,  5708,  5803,
+     5897,  5990,  6084,  6177,  6270,  6363,  6455,  6547,  6639,  6731,  6823,  6914,
+     7005,  7096,  7186,  7276,  7366,  7456,  7545,  7635,  7723,  7812,  7900,  7988,
+     8076,  8163,  8250,  8337,  8423,  8509,  8595,  8680,  8765,  8850,  8935,  9019,
+     9102,  9186,  9269,  9352,  9434,  9516,  9598,  9679,  9760,  9841,  9921, 10001,
+    10080, 10159, 10238, 10316, 10394, 10471, 10549, 10625, 10702, 10778, 10853, 10928,
+    11003, 11077, 11151, 11224, 11297, 11370, 11442, 11514, 11585, 11656, 11727, 11797,
+    11866, 11935, 12004, 12072, 12140, 12207, 12274, 12340, 12406, 12472, 12537, 12601,
+    12665, 12729, 12792, 12854, 12916, 12978, 13039, 13100, 13160, 13219, 13279, 13337,
+    13395, 13453, 13510, 13567, 13623, 13678, 13733, 13788, 13842, 13896, 13949, 14001,
+    14053, 14104, 14155, 14206, 14256, 14305, 14354, 14402, 14449, 14497, 14543, 14589,
+    14635, 14680, 14724, 14768, 14811, 14854, 14896, 14937, 14978, 15019, 15059, 15098,
+    15137, 15175, 15213, 15250, 15286, 15322, 15357, 15392, 15426, 15460, 15493, 15525,
+    15557, 15588, 15619, 15649, 15679, 15707, 15736, 15763, 15791, 15817, 15843, 15868,
+    15893, 15917, 15941, 15964, 15986, 16008, 16029, 16049, 16069, 16088, 16107, 16125,
+    16143, 16160, 16176, 16192, 16207, 16221, 16235, 16248, 16261, 16273, 16284, 16295,
+    16305, 16315, 16324, 16332, 16340, 16347, 16353, 16359, 16364, 16369, 16373, 16376,
+    16379, 16381, 16383, 16384, 16384,
+};
+
+// x * k >> shift, for shift <= 16, without a 64 bit product
+static int32_t mulShift (int32_t x, int16_t k, uint8_t shift)
+{
+    return ((x >> 16) * k) * ((int32_t)1 << (16 - shift)) + (int32_t)(((int32_t)(uint16_t)x * k) >> shift);
+}
+
+// x / d for d in Q2.14, without a 64 bit dividend
+static int32_t divQ14 (int32_t x, int16_t d)
+{
+    int32_t q = x / d;
+
+    return q * FIXED_UNIT + ((x - q * d) * FIXED_UNIT) / d;
+}
+
+// a binary angle at day in Q16.16, from its value at day 0 and its rate per day
+static bam_t angle (bam_t a0, int32_t rate, int32_t day)
+{
+    uint16_t fraction = (uint16_t)day;
+
+    return a0 + (bam_t)(day >> 16) * (bam_t)rate
+              + (bam_t)((rate >> 16) * fraction + (int32_t)(((uint32_t)(uint16_t)rate * fraction) >> 16));
+}
+
+// a linear element at day in Q16.16, from its rate per 256 days
+static int32_t drift (int32_t x0, int32_t rate, int32_t day)
+{
+    return x0 + (((day >> 16) * rate) >> 8);
+}
+
+int16_t fixedSin ( bam_t x ) __z88dk_fastcall
+{
+    uint32_t phase = (x >> 8) & 0x3fffff;                          // 22 bits within the quadrant
+    uint16_t i, f;
+    int16_t s;
+
+    if (x & 0x40000000)                                             // second and fourth quadrants mirror the first
+        phase = 0x400000 - phase;
+
+    i = (uint16_t)(phase >> 14);
+    f = (uint16_t)phase & 0x3fff;
+    s = (i < 256) ? sine[i] + (int16_t)(((int32_t)(sine[i+1] - sine[i]) * f) >> 14) : sine[256];
+
+    return (x & 0x80000000) ? -s : s;
+}
+
+int16_t fixedCos ( bam_t x ) __z88dk_fastcall
+{
+    return fixedSin(x + 0x40000000);
+}
+
+bam_t fixedEccentricAnomaly ( int16_t e, bam_t M ) __z88dk_callee
+{
+    int32_t error;
+    int16_t sinE, cosE;
+    uint8_t iterations = 0;
+    bam_t E;
+
+    sinE = fixedSin(M);
+    cosE = fixedCos(M);
+    E = M + (bam_t)mulShift(((int32_t)e * sinE >> 14) * (FIXED_UNIT + ((int32_t)e * cosE >> 14)), RAD_TO_BAM, 13);
+
+    do {
+        COUNT_ITERATION();
+        sinE = fixedSin(E);
+        cosE = fixedCos(E);
+        error = divQ14((int32_t)(E - M) - mulShift((int32_t)e * sinE, RAD_TO_BAM, 13), FIXED_UNIT - (int16_t)((int32_t)e * cosE >> 14));
+        E -= (bam_t)error;
+    } while ((error >= KEPLER_TOLERANCE_BAM || error <= -KEPLER_TOLERANCE_BAM) && ++iterations < KEPLER_ITERATIONS_MAX);
+
+    return E;
+}
+
+void fixedPlanetInit ( fixed_planet_t * fixed, const planet_t * planet )
+{
+    fixed->planet = planet;
+
+    fixed->N0 = (bam_t)(int32_t)(rev(planet->N0) * (BAM_PER_DEGREE/2.0)) << 1;     // halved, as 360 degrees overflows an int32_t
+    fixed->i0 = (bam_t)(int32_t)(rev(planet->i0) * (BAM_PER_DEGREE/2.0)) << 1;
+    fixed->w0 = (bam_t)(int32_t)(rev(planet->w0) * (BAM_PER_DEGREE/2.0)) << 1;
+    fixed->M0 = (bam_t)(int32_t)(rev(planet->M0) * (BAM_PER_DEGREE/2.0)) << 1;
+    fixed->Nc = (int32_t)(planet->Nc * BAM_PER_DEGREE);
+    fixed->ic = (int32_t)(planet->ic * BAM_PER_DEGREE);
+    fixed->wc = (int32_t)(planet->wc * BAM_PER_DEGREE);
+    fixed->Mc = (int32_t)(planet->Mc * BAM_PER_DEGREE);
+
+    fixed->a0 = (fixed_t)(planet->a0 * FIXED_ONE);
+    fixed->ac = (int32_t)(planet->ac * (FIXED_ONE * 256.0));
+    fixed->e0 = (int32_t)(planet->e0 * 1073741824.0);
+    fixed->ec = (int32_t)(planet->ec * (1073741824.0 * 256.0));
+    fixed->sqrte = (int16_t)(SQRT(1.0 - SQR(planet->e0)) * FIXED_UNIT);
+}
+
+void fixedSunCoordinates ( fixed_coordinates_t * sun, int32_t day )
+{
+    bam_t M = angle(SUN_M0, SUN_MC, day);
+    bam_t C = (bam_t)(mulShift(SUN_C1, fixedSin(M), 14) + mulShift(SUN_C2, fixedSin(M << 1), 14) + mulShift(SUN_C3, fixedSin(M * 3), 14));
+    bam_t LS = angle(SUN_L0, SUN_LC, day) + C;                     // true ecliptical longitude of Sun
+
+    fixed_t distanceInAU = divQ14(SUN_R, FIXED_UNIT + (int16_t)((int32_t)SUN_E * fixedCos(M + C) >> 14));
+
+    sun->x = mulShift(distanceInAU, fixedCos(LS), 14);
+    sun->y = mulShift(distanceInAU, fixedSin(LS), 14);
+    sun->z = 0;
+
+    sun->au = distanceInAU;
+}
+
+void fixedPlanetCoordinates ( fixed_coordinates_t * location, const fixed_planet_t * fixed, int32_t day )
+{
+    bam_t N = angle(fixed->N0, fixed->Nc, day);
+    bam_t i = angle(fixed->i0, fixed->ic, day);
+    bam_t w = angle(fixed->w0, fixed->wc, day);
+    bam_t M = angle(fixed->M0, fixed->Mc, day);
+    fixed_t a = drift(fixed->a0, fixed->ac, day);
+    int16_t e = (int16_t)(drift(fixed->e0, fixed->ec, day) >> 16);
+
+    bam_t E = fixedEccentricAnomaly(e, M);
+    int16_t sinE = fixedSin(E), cosE = fixedCos(E);
+    int16_t sinw = fixedSin(w), cosw = fixedCos(w);
+    int16_t sinN = fixedSin(N), cosN = fixedCos(N);
+    fixed_t xv, yv, rcosVW, rsinVW, rsinVWcosi;
+
+    // Calculate the body's position in its own orbital plane, and its distance from the thing it is orbiting.
+    xv = mulShift(a, cosE - e, 14);
+    yv = mulShift(mulShift(a, fixed->sqrte, 14), sinE, 14);
+
+    // The true anomaly v is the angle of (xv, yv), so r*cos(v+w) and r*sin(v+w) follow from the angle sum identities.
+    rcosVW = mulShift(xv, cosw, 14) - mulShift(yv, sinw, 14);
+    rsinVW = mulShift(yv, cosw, 14) + mulShift(xv, sinw, 14);
+    rsinVWcosi = mulShift(rsinVW, fixedCos(i), 14);
+
+    // Now we are ready to calculate (unperturbed) ecliptic cartesian heliocentric coordinates.
+    location->x = mulShift(rcosVW, cosN, 14) - mulShift(rsinVWcosi, sinN, 14);
+    location->y = mulShift(rcosVW, sinN, 14) + mulShift(rsinVWcosi, cosN, 14);
+    location->z = mulShift(rsinVW, fixedSin(i), 14);
+
+    // save the radius from the sun in AU
+    location->au = a - mulShift(a, (int16_t)((int32_t)e * cosE >> 14), 14);
+}
+
+
+// The planet_motion.h functions, as a build variant replacing planet_motion_fns.c,
+// and the planet_motion_sky.h functions, replacing planet_motion_sky.c and planet_motion_step.c.
+
+static fixed_planet_t fixedPlanets[PLANETS];
+static fixed_planet_t fixedOther;
+
+// the fixed point elements of planet, converted on first use
+static const fixed_planet_t * fixedPlanet (const planet_t * planet)
+{
+    uint8_t p;
+
+    for (p = 0; p < PLANETS; ++p) {
+        if (planets[p] == planet) {
+            if (fixedPlanets[p].planet != planet)
+                fixedPlanetInit(&fixedPlanets[p], planet);
+            return &fixedPlanets[p];
+        }
+    }
+    if (fixedOther.planet != planet)
+        fixedPlanetInit(&fixedOther, planet);
+    return &fixedOther;
+}
+
+static int32_t fixedDay (FLOAT day)
+{
+    return (int32_t)(day * FIXED_DAY);
+}
+
+static void fixedToCartesian (cartesian_coordinates_t * location, const fixed_coordinates_t * fixed)
+{
+    location->x = fixed->x * (1.0/FIXED_ONE);
+    location->y = fixed->y * (1.0/FIXED_ONE);
+    location->z = fixed->z * (1.0/FIXED_ONE);
+    location->au = fixed->au * (1.0/FIXED_ONE);
+}
+
+void sunEclipticCartesianCoordinates ( cartesian_coordinates_t * sun ) __z88dk_fastcall
+{
+    fixed_coordinates_t fixed;
+
+    fixedSunCoordinates(&fixed, fixedDay(sun->day));
+    fixedToCartesian(sun, &fixed);
+}
+
+void planetEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const planet_t * planet ) __z88dk_callee
+{
+    fixed_coordinates_t fixed;
+
+    fixedPlanetCoordinates(&fixed, fixedPlanet(planet), fixedDay(location->day));
+    fixedToCartesian(location, &fixed);
+}
+
+FLOAT eccentricAnomaly (FLOAT e, FLOAT M) __z88dk_callee
+{
+    bam_t E = fixedEccentricAnomaly((int16_t)(e * FIXED_UNIT), (bam_t)(int32_t)(rev(M) * (BAM_PER_DEGREE/2.0)) << 1);
+
+    return (E >> 1) * (2.0/BAM_PER_DEGREE);
+}
+
+void addCartesianCoordinates ( cartesian_coordinates_t * base, const cartesian_coordinates_t * addend ) __z88dk_callee
+{
+    base->x += addend->x;
+    base->y += addend->y;
+    base->z += addend->z;
+}
+
+#if ! defined(__MATH_MATH32) && ! defined(__MATH_AM9511)
+FLOAT rev (FLOAT x) __z88dk_fastcall
+{
+    return x - FLOOR(x*(1/360.0))*360.0;
+}
+#endif
+
+void skyInit ( sky_t * sky, const planet_t * const * planet, uint8_t bodies, FLOAT day, FLOAT step )
+{
+    uint8_t b;
+
+    (void)day;
+    (void)step;
+
+    if (bodies > SKY_BODIES_MAX)
+        bodies = SKY_BODIES_MAX;
+
+    sky->bodies = bodies;
+    sky->planet = planet;
+
+    for (b = 0; b < bodies; ++b)
+        fixedPlanet(planet[b]);
+}
+
+void skyCoordinates ( sky_t * sky, FLOAT day ) __z88dk_callee
+{
+    cartesian_coordinates_t * helio = sky->helio;
+    cartesian_coordinates_t * geo = sky->geo;
+    fixed_coordinates_t sunFixed, body;
+    int32_t fixed = fixedDay(day);
+    uint8_t b;
+
+    fixedSunCoordinates(&sunFixed, fixed);
+    fixedToCartesian(&sky->sun, &sunFixed);
+    sky->sun.day = day;
+
+    for (b = 0; b < sky->bodies; ++b, ++helio, ++geo) {
+        const planet_t * planet = sky->planet[b];
+
+        fixedPlanetCoordinates(&body, fixedPlanet(planet), fixed);
+
+        if (planet == &sun || planet == &moon) {                    // orbits the Earth
+            fixedToCartesian(geo, &body);
+            body.x -= sunFixed.x;
+            body.y -= sunFixed.y;
+            body.z -= sunFixed.z;
+            fixedToCartesian(helio, &body);
+        } else {
+            fixedToCartesian(helio, &body);
+            body.x += sunFixed.x;
+            body.y += sunFixed.y;
+            body.z += sunFixed.z;
+            fixedToCartesian(geo, &body);
+        }
+        helio->day = geo->day = day;
+    }
+}
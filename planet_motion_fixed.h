@@ -0,0 +1,106 @@
+/*
+ * planet_motion_fixed.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_FIXED_H
+#define _PLANET_MOTION_FIXED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fixed point ephemeris, for targets without a floating point unit.
+//
+// Angles are binary angles, where 2^32 is 360 degrees, so rev() is the wrap of unsigned arithmetic.
+// Coordinates are Q8.24 AU, sines, cosines and eccentricities Q2.14, and days Q16.16.
+// The trigonometry is a quarter wave table of 256 steps with linear interpolation, and Kepler's
+// equation is solved by Newton's method on binary angles, so only converting the elements of a
+// planet_t and the results to FLOAT needs floating point.
+//
+// The Sun's T^2 terms and the drift of its equation of centre and eccentricity over T are left out,
+// which moves it less than 0.01 pixel between 2000 and 2050.
+
+#define FIXED_ONE           16777216L       // 1.0 AU in Q8.24
+#define FIXED_UNIT          16384           // 1.0 in Q2.14
+#define FIXED_DAY           65536L          // 1 day in Q16.16
+
+#define BAM_PER_DEGREE      (4294967296.0/360.0)
+
+// type definitions
+
+typedef uint32_t bam_t;     // binary angle, 2^32 = 360 degrees.
+typedef int32_t fixed_t;    // Q8.24 AU.
+
+typedef struct fixed_coordinates_s {
+    fixed_t x;
+    fixed_t y;
+    fixed_t z;
+    fixed_t au;             // radius in AU
+} fixed_coordinates_t;
+
+typedef struct fixed_planet_s {     // a planet_t as fixed point
+    const planet_t * planet;
+    bam_t N0, i0, w0, M0;   // at day 0.
+    int32_t Nc, ic, wc, Mc; // binary angle per day.
+    fixed_t a0;
+    int32_t ac;             // Q8.24 AU per 256 days.
+    int32_t e0;             // Q2.30.
+    int32_t ec;             // Q2.30 per 256 days.
+    int16_t sqrte;          // sqrt(1 - e*e) at day 0, Q2.14.
+} fixed_planet_t;
+
+// fixed point functions (C)
+
+// sin and cos of a binary angle, Q2.14
+int16_t fixedSin ( bam_t x ) __z88dk_fastcall;
+int16_t fixedCos ( bam_t x ) __z88dk_fastcall;
+
+// eccentric anomaly from the eccentricity (Q2.14) and mean anomaly
+bam_t fixedEccentricAnomaly ( int16_t e, bam_t M ) __z88dk_callee;
+
+// Convert the elements of planet, using floating point.
+void fixedPlanetInit ( fixed_planet_t * fixed, const planet_t * planet );
+
+// As sunEclipticCartesianCoordinates() and planetEclipticCartesianCoordinates(), for day in Q16.16.
+void fixedSunCoordinates ( fixed_coordinates_t * sun, int32_t day );
+void fixedPlanetCoordinates ( fixed_coordinates_t * location, const fixed_planet_t * fixed, int32_t day );
+
+// The planet_motion.h and planet_motion_sky.h functions of planet_motion_fixed.c, as built for the host by the Makefile.
+// The sky is computed directly each day, as the fixed point planets are cheaper than the floating point steppers.
+#ifndef __Z88DK
+void fixSunEclipticCartesianCoordinates ( cartesian_coordinates_t * sun );
+void fixPlanetEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const planet_t * planet );
+FLOAT fixEccentricAnomaly ( FLOAT e, FLOAT M );
+void fixSkyInit ( struct sky_s * sky, const planet_t * const * planet, uint8_t bodies, FLOAT day, FLOAT step );
+void fixSkyCoordinates ( struct sky_s * sky, FLOAT day );
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_FIXED_H  */
@@ -0,0 +1,223 @@
+/*
+ * planet_motion_fixed_report.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host report of the accuracy, in pixels, and the speed of the planet_motion_fixed.c fixed point
+    functions against the floating point ones.
+
+    build and run with:
+
+    make
+    ./planet_motion_fixed_report [start_day] [days] [repeat]
+
+    Each body is computed by planet_motion_fixed.c and planet_motion_fns.c over the days, reporting
+    the largest difference in pixels at the scale the animation draws it, and the time per call of each.
+    Then the animation's sky is computed by planet_motion_fixed.c and by the planet_motion_sky.c
+    steppers, reporting for each body the largest difference in pixels, the frames where it is drawn
+    at a different pixel, and the time per frame of each.
+
+    On the host the floating point is in hardware, so the times only compare the work done, not the
+    soft float a Z80 without an APU would run.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion_regis.h"
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+#include "planet_motion_render.h"
+#include "planet_motion_fixed.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+#define REPEAT              10
+
+static const planet_t * const bodies[] = { &moon, &mercury, &venus, &mars, &jupiter, &saturn };
+
+#define BODIES              (sizeof(bodies)/sizeof(bodies[0]))
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+static uint16_t repeat = REPEAT;
+
+static sky_t sky, skyFixed;
+
+static volatile FLOAT sink;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+// pixels per AU that the animation draws planet at
+static double scale (const planet_t * planet)
+{
+    return (planet == &moon) ? 100 * RENDER_SCALE_AU : RENDER_SCALE_AU;
+}
+
+static double pixels (const cartesian_coordinates_t * a, const cartesian_coordinates_t * b, double scale)
+{
+    return hypot(a->x - b->x, a->y - b->y) * scale;
+}
+
+// the pixel the animation draws the coordinates at differs
+static uint8_t moved (const cartesian_coordinates_t * a, const cartesian_coordinates_t * b, double scale)
+{
+    return (int16_t)(a->x * scale) != (int16_t)(b->x * scale) || (int16_t)(a->y * scale) != (int16_t)(b->y * scale);
+}
+
+static void functions (void)
+{
+    cartesian_coordinates_t reference, location;
+    double start, timeFloat, timeFixed, error;
+    uint16_t d, r;
+    uint8_t p;
+
+    printf("%-8s %10s %10s %10s %8s\n", "body", "error px", "float ns", "fixed ns", "speedup");
+
+    for (p = 0; p < PLANETS; ++p) {
+        const planet_t * planet = planets[p];
+
+        error = 0.0;
+        for (d = 0; d < days; ++d) {
+            reference.day = location.day = startDay + d;
+            if (p == 0) {
+                sunEclipticCartesianCoordinates(&reference);
+                fixSunEclipticCartesianCoordinates(&location);
+            } else {
+                planetEclipticCartesianCoordinates(&reference, planet);
+                fixPlanetEclipticCartesianCoordinates(&location, planet);
+            }
+            if (pixels(&reference, &location, scale(planet)) > error)
+                error = pixels(&reference, &location, scale(planet));
+        }
+
+        start = now();
+        for (r = 0; r < repeat; ++r) {
+            for (d = 0; d < days; ++d) {
+                reference.day = startDay + d;
+                if (p == 0)
+                    sunEclipticCartesianCoordinates(&reference);
+                else
+                    planetEclipticCartesianCoordinates(&reference, planet);
+                sink = reference.x;
+            }
+        }
+        timeFloat = now() - start;
+
+        start = now();
+        for (r = 0; r < repeat; ++r) {
+            for (d = 0; d < days; ++d) {
+                location.day = startDay + d;
+                if (p == 0)
+                    fixSunEclipticCartesianCoordinates(&location);
+                else
+                    fixPlanetEclipticCartesianCoordinates(&location, planet);
+                sink = location.x;
+            }
+        }
+        timeFixed = now() - start;
+
+        printf("%-8s %10.4f %10.1f %10.1f %8.2f\n", p == 0 ? "Sun" : planet->name, error,
+               timeFloat * 1.0e9 / ((double)repeat * days), timeFixed * 1.0e9 / ((double)repeat * days), timeFloat / timeFixed);
+    }
+}
+
+static void animation (void)
+{
+    double error[BODIES] = {0.0};
+    uint16_t frames[BODIES] = {0};
+    double errorSun = 0.0, start, timeFloat, timeFixed;
+    uint16_t framesSun = 0, d, r;
+    uint8_t b;
+
+    skyInit(&sky, bodies, BODIES, startDay, 1.0);
+    fixSkyInit(&skyFixed, bodies, BODIES, startDay, 1.0);
+
+    for (d = 0; d < days; ++d) {
+        skyCoordinates(&sky, startDay + d);
+        fixSkyCoordinates(&skyFixed, startDay + d);
+
+        if (pixels(&sky.sun, &skyFixed.sun, RENDER_SCALE_AU) > errorSun)
+            errorSun = pixels(&sky.sun, &skyFixed.sun, RENDER_SCALE_AU);
+        framesSun += moved(&sky.sun, &skyFixed.sun, RENDER_SCALE_AU);
+
+        for (b = 0; b < BODIES; ++b) {
+            if (pixels(&sky.geo[b], &skyFixed.geo[b], scale(bodies[b])) > error[b])
+                error[b] = pixels(&sky.geo[b], &skyFixed.geo[b], scale(bodies[b]));
+            frames[b] += moved(&sky.geo[b], &skyFixed.geo[b], scale(bodies[b]));
+        }
+    }
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        skyInit(&sky, bodies, BODIES, startDay, 1.0);
+        for (d = 0; d < days; ++d)
+            skyCoordinates(&sky, startDay + d);
+    }
+    timeFloat = now() - start;
+
+    start = now();
+    for (r = 0; r < repeat; ++r) {
+        fixSkyInit(&skyFixed, bodies, BODIES, startDay, 1.0);
+        for (d = 0; d < days; ++d)
+            fixSkyCoordinates(&skyFixed, startDay + d);
+    }
+    timeFixed = now() - start;
+
+    printf("\n%-8s %10s %10s\n", "sky", "error px", "frames");
+    printf("%-8s %10.4f %10u\n", "Sun", errorSun, framesSun);
+    for (b = 0; b < BODIES; ++b)
+        printf("%-8s %10.4f %10u\n", bodies[b]->name, error[b], frames[b]);
+    printf("\n%u frames, steppers %.1f ns/frame, fixed point %.1f ns/frame, speedup %.2f\n", days,
+           timeFloat * 1.0e9 / ((double)repeat * days), timeFixed * 1.0e9 / ((double)repeat * days), timeFloat / timeFixed);
+}
+
+int main (int argc, char ** argv)
+{
+    if (argc > 1) startDay = (uint16_t)atoi(argv[1]);
+    if (argc > 2) days = (uint16_t)atoi(argv[2]);
+    if (argc > 3) repeat = (uint16_t)atoi(argv[3]);
+    if (argc > 4 || days == 0 || repeat == 0) {
+        fprintf(stderr, "usage: %s [start_day] [days] [repeat]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%u days from day %u, at %u pixels per AU, the Moon at %u\n\n", days, startDay, RENDER_SCALE_AU, 100 * RENDER_SCALE_AU);
+
+    functions();
+    animation();
+    return 0;
+}
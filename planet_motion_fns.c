@@ -1,11 +1,17 @@
 
 #include <stdint.h>
+#include <stddef.h>
 #include <math.h>
 
 #include "planet_motion.h"
 
+#ifdef PLANET_MOTION_COUNT
+uint32_t eccentricAnomalyIterations;
+#endif
+
 void sunEclipticCartesianCoordinates ( cartesian_coordinates_t * sun) __z88dk_fastcall
 {
+    PROFILE_BODY(NULL)
     // We use formulas for finding the Sun as seen from Earth, 
     // then negate the (x,y,z) coordinates obtained to get the Earth's position 
     // from the Sun's perspective.
@@ -23,22 +29,24 @@ void sunEclipticCartesianCoordinates ( cartesian_coordinates_t * sun) __z88dk_fa
     FLOAT M0 = rev(357.52910 + (35999.05030 * T) - (0.0001559 * T_SQR) - (0.00000048 * T * T_SQR));     // Sun's mean anomaly, in degrees
 
                                                                     // Sun's equation of center in degrees
-    FLOAT C = rev((1.914600 - 0.004817 * T - 0.000014 * T_SQR) * SIN(RAD(M0)) + (0.01993 - 0.000101 * T) * SIN(RAD(2*M0)) + 0.000290 * SIN(RAD(3*M0)));
+    FLOAT C = rev((1.914600 - 0.004817 * T - 0.000014 * T_SQR) * SIND(M0) + (0.01993 - 0.000101 * T) * SIND(2*M0) + 0.000290 * SIND(3*M0));
 
     FLOAT LS = rev(L0 + C);                                         // true ecliptical longitude of Sun
 
     FLOAT e = 0.016708617 - T * (0.000042037 + T * 0.0000001236);   // The eccentricity of the Earth's orbit.
-    FLOAT distanceInAU = (1.000001018 * (1 - SQR(e))) / (1 + e * COS(RAD(M0 + C))); // distance from Sun to Earth in astronomical units (AU)
-    sun->x = distanceInAU * COS(RAD(LS));
-    sun->y = distanceInAU * SIN(RAD(LS));
+    FLOAT distanceInAU = (1.000001018 * (1 - SQR(e))) / (1 + e * COSD(M0 + C)); // distance from Sun to Earth in astronomical units (AU)
+    sun->x = distanceInAU * COSD(LS);
+    sun->y = distanceInAU * SIND(LS);
     sun->z = 0.0;                                                   // the Earth's center is always on the plane of the ecliptic (z=0), by definition!
 
     sun->au = distanceInAU;
+    PROFILE_COUNT(PROFILE_POSITIONS);
 }
 
 
 void planetEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const planet_t * planet ) __z88dk_callee
 {
+    PROFILE_BODY(planet)
     FLOAT day = location->day;
 
     FLOAT N = rev( planet->N0 + (day * planet->Nc) );
@@ -52,18 +60,17 @@ void planetEclipticCartesianCoordinates ( cartesian_coordinates_t * location, co
     FLOAT E = rev(eccentricAnomaly (e, M));
 
     // Calculate the body's position in its own orbital plane, and its distance from the thing it is orbiting.
-    FLOAT xv = a * (COS(RAD(E)) - e);
-    FLOAT yv = a * SQRT(1.0 - SQR(e)) * SIN(RAD(E));
+    FLOAT xv = a * (COSD(E) - e);
+    FLOAT yv = a * SQRT(1.0 - SQR(e)) * SIND(E);
 
-    FLOAT v = DEG(ATAN2(yv, xv));       // True anomaly in degrees: the angle from perihelion of the body as seen by the Sun.
+    FLOAT v = ATAN2D(yv, xv);          // True anomaly in degrees: the angle from perihelion of the body as seen by the Sun.
     FLOAT r = HYPOT(xv, yv);            // Distance from the Sun to the planet in AU
 
-    FLOAT cosN  = COS(RAD(N));
-    FLOAT sinN  = SIN(RAD(N));
-    FLOAT cosi  = COS(RAD(i));
-    FLOAT sini  = SIN(RAD(i));
-    FLOAT cosVW = COS(RAD(v+w));
-    FLOAT sinVW = SIN(RAD(v+w));
+    FLOAT cosN, sinN, cosi, sini, cosVW, sinVW;
+
+    SINCOSD(N, &sinN, &cosN);
+    SINCOSD(i, &sini, &cosi);
+    SINCOSD(v+w, &sinVW, &cosVW);
 
     // Now we are ready to calculate (unperturbed) ecliptic cartesian heliocentric coordinates.
     location->x = r * (cosN*cosVW - sinN*sinVW*cosi);
@@ -72,20 +79,24 @@ void planetEclipticCartesianCoordinates ( cartesian_coordinates_t * location, co
 
     // save the radius from the sun in AU
     location->au = r;
+    PROFILE_COUNT(PROFILE_POSITIONS);
 }
 
 
 FLOAT eccentricAnomaly (FLOAT e, FLOAT M) __z88dk_callee
 {
-    FLOAT E, error;
+    FLOAT E, error, sinE, cosE;
 
-    E = M + (e * SIN(RAD(M)) * (1.0 + (e * COS(RAD(M)))));
+    PROFILE_COUNT(PROFILE_KEPLER);
+    E = M + DEG(e * SIND(M) * (1.0 + (e * COSD(M))));
 
     do {
-        error = (E - DEG(e * SIN(RAD(E))) - M) / (1 - e * COS(RAD(E)));
+        COUNT_ITERATION();
+        SINCOSD(E, &sinE, &cosE);
+        error = (E - DEG(e * sinE) - M) / (1 - e * cosE);
         E -= error;
         error = FABS(error);
-    } while (error >= 1.0e-3);          // the angle is good enough for our purposes
+    } while (error >= KEPLER_TOLERANCE);    // the angle is good enough for our purposes
 
     return E;
 }
@@ -100,7 +111,7 @@ void addCartesianCoordinates ( cartesian_coordinates_t * base, const cartesian_c
 #if ! defined(__MATH_MATH32) && ! defined(__MATH_AM9511)
 FLOAT rev (FLOAT x) __z88dk_fastcall
 {
-    return x - FLOOR(x*(1/360.0))*360.0;
+    return PROFILED(PROFILE_REV, x - FLOOR(x*(1/360.0))*360.0);
 }
 #endif
 
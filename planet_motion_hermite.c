@@ -0,0 +1,162 @@
+
+#include <stdint.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_hermite.h"
+
+// The velocity is the derivative of the Keplerian position with day, from the mean motion through
+// the eccentric anomaly, and the rates of the node, inclination and perihelion, rotating the orbit.
+//
+// Between keyframes each coordinate is the cubic Hermite of the positions and velocities at either
+// end, with an error of at most step^4/384 of the fourth derivative. For an orbit of semi-major
+// axis a, eccentricity e and mean motion n (rad/day) that is largest at perihelion, about
+// a n^4 (1+e)^2 / (1-e)^5, which is doubled for the radial terms to choose the step.
+
+void sunEclipticCartesianVelocity ( cartesian_coordinates_t * sun, cartesian_coordinates_t * velocity )
+{
+    // As sunEclipticCartesianCoordinates(), with the rates of its terms per day.
+    FLOAT T = (sun->day - 1.5) * 0.0000273785;                      // 36525.0 Julian centuries since J2000.0
+
+    FLOAT T_SQR = SQR(T);
+
+    FLOAT L0 = rev(280.46645 + (36000.76983 * T) + (0.0003032 * T_SQR));                            // Sun's mean longitude, in degrees
+    FLOAT M0 = rev(357.52910 + (35999.05030 * T) - (0.0001559 * T_SQR) - (0.00000048 * T * T_SQR));     // Sun's mean anomaly, in degrees
+    FLOAT dL0 = (36000.76983 + 0.0006064 * T) * 0.0000273785;                                       // per day
+    FLOAT dM0 = (35999.05030 - 0.0003118 * T - 0.00000144 * T_SQR) * 0.0000273785;
+
+    FLOAT c1 = 1.914600 - 0.004817 * T - 0.000014 * T_SQR;
+    FLOAT c2 = 0.01993 - 0.000101 * T;
+    FLOAT c3 = 0.000290;
+
+    FLOAT C = c1 * SIND(M0) + c2 * SIND(2*M0) + c3 * SIND(3*M0);    // Sun's equation of center in degrees
+    FLOAT dC = RAD(dM0) * (c1 * COSD(M0) + 2.0 * c2 * COSD(2*M0) + 3.0 * c3 * COSD(3*M0));
+
+    FLOAT LS = rev(L0 + C);                                         // true ecliptical longitude of Sun
+    FLOAT dLS = RAD(dL0 + dC);                                      // radians per day
+
+    FLOAT e = 0.016708617 - T * (0.000042037 + T * 0.0000001236);   // The eccentricity of the Earth's orbit.
+    FLOAT k = 1 + e * COSD(M0 + C);
+    FLOAT distanceInAU = (1.000001018 * (1 - SQR(e))) / k;          // distance from Sun to Earth in astronomical units (AU)
+    FLOAT dDistance = distanceInAU * e * SIND(M0 + C) * RAD(dM0 + dC) / k;
+
+    FLOAT sinLS, cosLS;
+
+    SINCOSD(LS, &sinLS, &cosLS);
+
+    sun->x = distanceInAU * cosLS;
+    sun->y = distanceInAU * sinLS;
+    sun->z = 0.0;
+    sun->au = distanceInAU;
+
+    velocity->x = dDistance * cosLS - sun->y * dLS;
+    velocity->y = dDistance * sinLS + sun->x * dLS;
+    velocity->z = 0.0;
+    velocity->au = dDistance;
+    velocity->day = sun->day;
+}
+
+void planetEclipticCartesianVelocity ( cartesian_coordinates_t * location, cartesian_coordinates_t * velocity, const planet_t * planet )
+{
+    FLOAT day = location->day;
+
+    FLOAT N = rev( planet->N0 + (day * planet->Nc) );
+    FLOAT i = rev( planet->i0 + (day * planet->ic) );
+    FLOAT w = rev( planet->w0 + (day * planet->wc) );
+    FLOAT a = planet->a0 + (day * planet->ac);
+    FLOAT e = planet->e0 + (day * planet->ec);
+    FLOAT M = rev( planet->M0 + (day * planet->Mc) );
+
+    FLOAT E = rev(eccentricAnomaly (e, M));
+    FLOAT dE = RAD(planet->Mc) / (1.0 - e * COSD(E));               // radians per day
+
+    FLOAT sinE, cosE, sinw, cosw, sinN, cosN, sini, cosi;
+    FLOAT sqrte, xv, yv, dxv, dyv, rcosVW, rsinVW, drcosVW, drsinVW;
+
+    SINCOSD(E, &sinE, &cosE);
+    SINCOSD(w, &sinw, &cosw);
+    SINCOSD(N, &sinN, &cosN);
+    SINCOSD(i, &sini, &cosi);
+
+    // Calculate the body's position and velocity in its own orbital plane.
+    sqrte = SQRT(1.0 - SQR(e));
+    xv = a * (cosE - e);
+    yv = a * sqrte * sinE;
+    dxv = -a * sinE * dE;
+    dyv = a * sqrte * cosE * dE;
+
+    // r*cos(v+w) and r*sin(v+w) by the angle sum identities, turning with the perihelion.
+    rcosVW = xv * cosw - yv * sinw;
+    rsinVW = yv * cosw + xv * sinw;
+    drcosVW = dxv * cosw - dyv * sinw - rsinVW * RAD(planet->wc);
+    drsinVW = dyv * cosw + dxv * sinw + rcosVW * RAD(planet->wc);
+
+    // Now we are ready to calculate (unperturbed) ecliptic cartesian heliocentric coordinates, turning with the node and inclination.
+    location->x = cosN*rcosVW - sinN*rsinVW*cosi;
+    location->y = sinN*rcosVW + cosN*rsinVW*cosi;
+    location->z = rsinVW * sini;
+    location->au = a * (1.0 - e * cosE);
+
+    velocity->x = cosN*drcosVW - sinN*cosi*drsinVW - location->y * RAD(planet->Nc) + sinN*rsinVW*sini * RAD(planet->ic);
+    velocity->y = sinN*drcosVW + cosN*cosi*drsinVW + location->x * RAD(planet->Nc) - cosN*rsinVW*sini * RAD(planet->ic);
+    velocity->z = drsinVW * sini + rsinVW * cosi * RAD(planet->ic);
+    velocity->au = a * e * sinE * dE;
+    velocity->day = day;
+}
+
+void hermiteInit ( hermite_t * hermite, const planet_t * planet, FLOAT tolerance )
+{
+    FLOAT a = planet ? planet->a0 : 1.000001018;
+    FLOAT e = planet ? planet->e0 : 0.016708617;
+    FLOAT n = RAD(planet ? planet->Mc : 0.9856002585);
+    FLOAT bound = 2.0 * a * SQR(SQR(n)) * SQR(1.0 + e) / POW(1.0 - e, 5.0);    // of the fourth derivative
+
+    hermite->planet = planet;
+    hermite->step = SQRT(SQRT(384.0 * tolerance / bound));
+    if (hermite->step > HERMITE_STEP_MAX)
+        hermite->step = HERMITE_STEP_MAX;
+    hermite->day = 0.0;
+    hermite->keyframes = 0;
+}
+
+static void hermiteKeyframe (hermite_t * hermite, cartesian_coordinates_t * p, cartesian_coordinates_t * v, FLOAT day)
+{
+    p->day = day;
+    if (hermite->planet)
+        planetEclipticCartesianVelocity(p, v, hermite->planet);
+    else
+        sunEclipticCartesianVelocity(p, v);
+    ++hermite->keyframes;
+}
+
+void hermiteEclipticCartesianCoordinates ( cartesian_coordinates_t * location, hermite_t * hermite ) __z88dk_callee
+{
+    FLOAT day = location->day;
+    FLOAT step = hermite->step;
+    FLOAT s, s2, s3, h00, h10, h01, h11;
+
+    if (hermite->keyframes == 0 || day < hermite->day || day > hermite->day + 2.0 * step) {
+        hermite->day = day;                                         // start again from this day
+        hermiteKeyframe(hermite, &hermite->p0, &hermite->v0, day);
+        hermiteKeyframe(hermite, &hermite->p1, &hermite->v1, day + step);
+    } else if (day > hermite->day + step) {
+        hermite->day += step;                                       // move on to the next keyframe
+        hermite->p0 = hermite->p1;
+        hermite->v0 = hermite->v1;
+        hermiteKeyframe(hermite, &hermite->p1, &hermite->v1, hermite->day + step);
+    }
+
+    s = (day - hermite->day) / step;
+    s2 = s * s;
+    s3 = s2 * s;
+
+    h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    h10 = (s3 - 2.0 * s2 + s) * step;
+    h01 = 3.0 * s2 - 2.0 * s3;
+    h11 = (s3 - s2) * step;
+
+    location->x = h00 * hermite->p0.x + h10 * hermite->v0.x + h01 * hermite->p1.x + h11 * hermite->v1.x;
+    location->y = h00 * hermite->p0.y + h10 * hermite->v0.y + h01 * hermite->p1.y + h11 * hermite->v1.y;
+    location->z = h00 * hermite->p0.z + h10 * hermite->v0.z + h01 * hermite->p1.z + h11 * hermite->v1.z;
+    location->au = h00 * hermite->p0.au + h10 * hermite->v0.au + h01 * hermite->p1.au + h11 * hermite->v1.au;
+}
@@ -0,0 +1,71 @@
+/*
+ * planet_motion_hermite.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_HERMITE_H
+#define _PLANET_MOTION_HERMITE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Keyframe days are chosen so the cubic Hermite error is within tolerance, but no further apart than this.
+
+#define HERMITE_STEP_MAX    32.0            // days
+
+// type definitions
+
+typedef struct hermite_s {          // a body interpolated between keyframes
+    const planet_t * planet;        // or NULL for the Sun, seen from Earth.
+    FLOAT step;             // days between keyframes.
+    FLOAT day;              // day of the first keyframe.
+    cartesian_coordinates_t p0, v0; // position and velocity (per day) at day, and at day + step.
+    cartesian_coordinates_t p1, v1;
+    uint32_t keyframes;     // keyframes solved since hermiteInit(), 0 before the first call.
+} hermite_t;
+
+// velocity functions (C)
+
+// As sunEclipticCartesianCoordinates() and planetEclipticCartesianCoordinates(), with the velocity in AU per day,
+// where velocity->au is the rate of change of the radius. The slow drift of a and e is left out of the velocity.
+void sunEclipticCartesianVelocity ( cartesian_coordinates_t * sun, cartesian_coordinates_t * velocity );
+void planetEclipticCartesianVelocity ( cartesian_coordinates_t * location, cartesian_coordinates_t * velocity, const planet_t * planet );
+
+// Hermite functions (C)
+
+// Prepare to interpolate planet, or the Sun when planet is NULL, to within about tolerance (AU).
+void hermiteInit ( hermite_t * hermite, const planet_t * planet, FLOAT tolerance );
+
+// As sunEclipticCartesianCoordinates() or planetEclipticCartesianCoordinates(), for any location->day,
+// interpolated between the keyframes either side, which are solved as the day moves past them.
+void hermiteEclipticCartesianCoordinates ( cartesian_coordinates_t * location, hermite_t * hermite ) __z88dk_callee;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_HERMITE_H  */
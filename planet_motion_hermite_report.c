@@ -0,0 +1,189 @@
+/*
+ * planet_motion_hermite_report.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host report of the analytic velocities and the Hermite keyframe interpolation.
+
+    build and run with:
+
+    make
+    ./planet_motion_hermite_report [-f frames_per_day] [-p pixels] [start_day] [days]
+
+    The velocity of each body is compared with the central difference of its positions three hours
+    either side, which is limited by the FLOAT rounding of the positions, about 1e-5 AU. Then each body is interpolated at frames_per_day frames a day, with keyframes
+    chosen for an error of pixels at the animation's scale, and compared with the full solution
+    of every frame, reporting the largest error in pixels, the keyframes solved, and the time per
+    frame of each.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_hermite.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+#define FRAMES_PER_DAY      24
+#define PIXELS              0.1
+#define SCALE               48.0                                    // RENDER_SCALE_AU
+#define DELTA               0.125                                   // days, exact in a FLOAT day
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+static uint16_t framesPerDay = FRAMES_PER_DAY;
+static double tolerance = PIXELS;
+
+static volatile FLOAT sink;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+static double scale (uint8_t p)
+{
+    return (planets[p] == &moon) ? 100.0 * SCALE : SCALE;
+}
+
+static void solve (cartesian_coordinates_t * location, uint8_t p)
+{
+    if (p == 0)
+        sunEclipticCartesianCoordinates(location);
+    else
+        planetEclipticCartesianCoordinates(location, planets[p]);
+}
+
+static void velocities (void)
+{
+    cartesian_coordinates_t location, velocity, before, after;
+    double error, errorMax, speed;
+    uint16_t d;
+    uint8_t p;
+
+    printf("%-8s %14s %14s %12s\n", "body", "speed AU/day", "error AU/day", "relative");
+
+    for (p = 0; p < PLANETS; ++p) {
+        errorMax = speed = 0.0;
+        for (d = 0; d < days; ++d) {
+            location.day = startDay + d;
+            before.day = location.day - DELTA;
+            after.day = location.day + DELTA;
+            if (p == 0)
+                sunEclipticCartesianVelocity(&location, &velocity);
+            else
+                planetEclipticCartesianVelocity(&location, &velocity, planets[p]);
+            solve(&before, p);
+            solve(&after, p);
+
+            error = hypot(hypot(velocity.x - (after.x - before.x) / (2.0 * DELTA), velocity.y - (after.y - before.y) / (2.0 * DELTA)),
+                          velocity.z - (after.z - before.z) / (2.0 * DELTA));
+            if (error > errorMax)
+                errorMax = error;
+            if (hypot(hypot(velocity.x, velocity.y), velocity.z) > speed)
+                speed = hypot(hypot(velocity.x, velocity.y), velocity.z);
+        }
+        printf("%-8s %14.3e %14.3e %12.2e\n", p == 0 ? "Sun" : planets[p]->name, speed, errorMax, errorMax / speed);
+    }
+}
+
+static void interpolation (void)
+{
+    cartesian_coordinates_t location, reference;
+    hermite_t hermite;
+    double error, start, timeSolve, timeHermite;
+    uint32_t frames = (uint32_t)days * framesPerDay, f;
+    uint8_t p;
+
+    printf("\n%u frames a day, keyframes for %.3f pixels at %.0f pixels per AU, the Moon at %.0f\n\n", framesPerDay, tolerance, SCALE, 100.0 * SCALE);
+    printf("%-8s %10s %10s %10s %10s %10s %8s\n", "body", "step days", "keyframes", "error px", "solve ns", "hermite ns", "speedup");
+
+    for (p = 0; p < PLANETS; ++p) {
+        hermiteInit(&hermite, p == 0 ? NULL : planets[p], tolerance / scale(p));
+
+        error = 0.0;
+        for (f = 0; f < frames; ++f) {
+            location.day = reference.day = startDay + (FLOAT)f / framesPerDay;
+            hermiteEclipticCartesianCoordinates(&location, &hermite);
+            solve(&reference, p);
+            if (hypot(hypot(location.x - reference.x, location.y - reference.y), location.z - reference.z) * scale(p) > error)
+                error = hypot(hypot(location.x - reference.x, location.y - reference.y), location.z - reference.z) * scale(p);
+        }
+
+        start = now();
+        for (f = 0; f < frames; ++f) {
+            reference.day = startDay + (FLOAT)f / framesPerDay;
+            solve(&reference, p);
+            sink = reference.x;
+        }
+        timeSolve = now() - start;
+
+        hermiteInit(&hermite, p == 0 ? NULL : planets[p], tolerance / scale(p));
+        start = now();
+        for (f = 0; f < frames; ++f) {
+            location.day = startDay + (FLOAT)f / framesPerDay;
+            hermiteEclipticCartesianCoordinates(&location, &hermite);
+            sink = location.x;
+        }
+        timeHermite = now() - start;
+
+        printf("%-8s %10.3f %10u %10.4f %10.1f %10.1f %8.2f\n", p == 0 ? "Sun" : planets[p]->name, hermite.step, hermite.keyframes, error,
+               timeSolve * 1.0e9 / frames, timeHermite * 1.0e9 / frames, timeSolve / timeHermite);
+    }
+}
+
+int main (int argc, char ** argv)
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:p:")) != -1) {
+        switch (opt) {
+            case 'f': framesPerDay = (uint16_t)atoi(optarg); break;
+            case 'p': tolerance = atof(optarg); break;
+            default: framesPerDay = 0; break;
+        }
+    }
+    if (optind < argc) startDay = (uint16_t)atoi(argv[optind]);
+    if (optind + 1 < argc) days = (uint16_t)atoi(argv[optind + 1]);
+    if (optind + 2 < argc || days == 0 || framesPerDay == 0 || tolerance <= 0.0) {
+        fprintf(stderr, "usage: %s [-f frames_per_day] [-p pixels] [start_day] [days]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%u days from day %u\n\n", days, startDay);
+
+    velocities();
+    interpolation();
+    return 0;
+}
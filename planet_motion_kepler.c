@@ -0,0 +1,202 @@
+
+#include <stdint.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_kepler.h"
+
+// Each correction costs one sine and cosine, so the iterations reported are corrections.
+//
+// KEPLER_HALLEY and KEPLER_TABLE stop once the error left by the last correction d, which for
+// Newton is about e*d*d/(2*(1-e)), is below the tolerance, so no correction is spent on confirming
+// convergence. KEPLER_FIXED and KEPLER_MARKLEY take the same steps for every M, so their time is
+// fixed, and only their accuracy depends on the orbit.
+
+const char * const keplerSolverNames[KEPLER_SOLVERS] = { "newton", "halley", "fixed", "table", "markley" };
+
+// Schlyter's second order starter
+static FLOAT starter (FLOAT e, FLOAT M)
+{
+    FLOAT sinM, cosM;
+
+    SINCOSD(M, &sinM, &cosM);
+    return M + DEG(e * sinM * (1.0 + e * cosM));
+}
+
+// Newton correction of E, in degrees
+static FLOAT newton (FLOAT e, FLOAT M, FLOAT E)
+{
+    FLOAT sinE, cosE;
+
+    COUNT_ITERATION();
+    SINCOSD(E, &sinE, &cosE);
+    return (M - E + DEG(e * sinE)) / (1.0 - e * cosE);
+}
+
+// the error left in E (deg) after a Newton correction of d degrees
+static FLOAT residual (FLOAT e, FLOAT d)
+{
+    return RAD(d * d) * e / (2.0 * (1.0 - e));
+}
+
+static FLOAT solveNewton (kepler_solver_t * solver, FLOAT e, FLOAT M, uint8_t * iterations)
+{
+    FLOAT E = starter(e, M);
+    FLOAT d;
+
+    do {
+        d = newton(e, M, E);
+        E += d;
+    } while (FABS(d) >= solver->tolerance && ++*iterations < KEPLER_ITERATIONS_MAX);
+
+    return E;
+}
+
+static FLOAT solveHalley (kepler_solver_t * solver, FLOAT e, FLOAT M, uint8_t * iterations)
+{
+    FLOAT E = starter(e, M);
+    FLOAT f0, f1, f2, sinE, cosE, d;
+
+    do {
+        COUNT_ITERATION();
+        SINCOSD(E, &sinE, &cosE);
+        f0 = RAD(E - M) - e * sinE;                                 // in radians
+        f1 = 1.0 - e * cosE;
+        f2 = e * sinE;
+        d = DEG(-f0 / (f1 - 0.5 * f0 * f2 / f1));
+        E += d;
+    } while (residual(e, d) >= solver->tolerance && ++*iterations < KEPLER_ITERATIONS_MAX);
+
+    return E;
+}
+
+static FLOAT solveFixed (kepler_solver_t * solver, FLOAT e, FLOAT M, uint8_t * iterations)
+{
+    FLOAT E = starter(e, M);
+    uint8_t i;
+
+    for (i = solver->fixed; i; --i)
+        E += newton(e, M, E);
+
+    *iterations = solver->fixed;
+    return E;
+}
+
+static FLOAT solveTable (kepler_solver_t * solver, FLOAT e, FLOAT M, uint8_t * iterations)
+{
+    FLOAT u = M * (KEPLER_TABLE_SIZE / 360.0);
+    uint8_t k = (uint8_t)u;
+    FLOAT E, d;
+
+    if (k >= KEPLER_TABLE_SIZE)
+        k = KEPLER_TABLE_SIZE - 1;
+    E = M + solver->table[k] + (u - k) * (solver->table[k+1] - solver->table[k]);
+
+    do {
+        d = newton(e, M, E);
+        E += d;
+    } while (residual(e, d) >= solver->tolerance && ++*iterations < KEPLER_ITERATIONS_MAX);
+
+    return E;
+}
+
+// F. L. Markley, Kepler Equation Solver, Celestial Mechanics and Dynamical Astronomy 63 (1995)
+static FLOAT solveMarkley (FLOAT e, FLOAT M)
+{
+    FLOAT m, alpha, d, q, r, w, E, sinE, cosE, f0, f1, f2, f3, d3, d4, d5;
+    uint8_t reflect = M > 180.0;
+
+    m = RAD(reflect ? 360.0 - M : M);                               // E(-M) = -E(M), so solve for m in [0, pi]
+
+    alpha = (3.0 * M_PI * M_PI + 1.6 * M_PI * (M_PI - m) / (1.0 + e)) / (M_PI * M_PI - 6.0);
+    d = 3.0 * (1.0 - e) + alpha * e;
+    q = 2.0 * alpha * d * (1.0 - e) - m * m;
+    r = 3.0 * alpha * d * (d - 1.0 + e) * m + m * m * m;
+    w = POW(FABS(r) + SQRT(q * q * q + r * r), 2.0/3.0);
+    E = DEG((2.0 * r * w / (w * w + w * q + q * q) + m) / d);       // the cubic starter
+
+    COUNT_ITERATION();
+    SINCOSD(E, &sinE, &cosE);
+    f0 = RAD(E) - e * sinE - m;
+    f1 = 1.0 - e * cosE;
+    f2 = e * sinE;
+    f3 = 1.0 - f1;
+    d3 = -f0 / (f1 - 0.5 * f0 * f2 / f1);
+    d4 = -f0 / (f1 + 0.5 * d3 * f2 + d3 * d3 * f3 * (1.0/6.0));
+    d5 = -f0 / (f1 + 0.5 * d4 * f2 + d4 * d4 * f3 * (1.0/6.0) - d4 * d4 * d4 * f2 * (1.0/24.0));
+    E += DEG(d5);
+
+    return reflect ? 360.0 - E : E;
+}
+
+// E for M by Newton, iterated well past any tolerance, for the table and the fixed corrections
+static FLOAT solveAccurate (FLOAT e, FLOAT M)
+{
+    FLOAT E = starter(e, M);
+    uint8_t i;
+
+    for (i = 0; i < KEPLER_ITERATIONS_MAX; ++i)
+        E += newton(e, M, E);
+    return E;
+}
+
+void keplerSolverInit ( kepler_solver_t * solver, uint8_t method, FLOAT e, FLOAT tolerance )
+{
+    FLOAT M, E, error, errorMax;
+    uint16_t k;
+    uint8_t iterations;
+
+    solver->method = method;
+    solver->tolerance = tolerance;
+    solver->fixed = 1;
+    keplerSolverReset(solver);
+
+    if (method == KEPLER_TABLE) {
+        for (k = 0; k <= KEPLER_TABLE_SIZE; ++k) {
+            M = k * (360.0 / KEPLER_TABLE_SIZE);
+            solver->table[k] = solveAccurate(e, M) - M;
+        }
+    }
+
+    if (method == KEPLER_FIXED) {                                   // the fewest corrections within tolerance at each degree of M
+        for ( ; solver->fixed < KEPLER_ITERATIONS_MAX; ++solver->fixed) {
+            errorMax = 0.0;
+            for (k = 0; k < 360; ++k) {
+                M = k;
+                E = solveFixed(solver, e, M, &iterations) - solveAccurate(e, M);
+                error = FABS(E);
+                if (error > errorMax)
+                    errorMax = error;
+            }
+            if (errorMax < tolerance)
+                break;
+        }
+    }
+}
+
+void keplerSolverReset ( kepler_solver_t * solver ) __z88dk_fastcall
+{
+    solver->calls = 0;
+    solver->iterations = 0;
+    solver->iterationsMax = 0;
+}
+
+FLOAT keplerSolve ( kepler_solver_t * solver, FLOAT e, FLOAT M ) __z88dk_callee
+{
+    uint8_t iterations = 1;
+    FLOAT E;
+
+    switch (solver->method) {
+        case KEPLER_HALLEY:     E = solveHalley(solver, e, M, &iterations); break;
+        case KEPLER_FIXED:      E = solveFixed(solver, e, M, &iterations); break;
+        case KEPLER_TABLE:      E = solveTable(solver, e, M, &iterations); break;
+        case KEPLER_MARKLEY:    E = solveMarkley(e, M); break;
+        default:                E = solveNewton(solver, e, M, &iterations); break;
+    }
+
+    ++solver->calls;
+    solver->iterations += iterations;
+    if (iterations > solver->iterationsMax)
+        solver->iterationsMax = iterations;
+    return E;
+}
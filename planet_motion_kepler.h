@@ -0,0 +1,76 @@
+/*
+ * planet_motion_kepler.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_KEPLER_H
+#define _PLANET_MOTION_KEPLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Kepler solver methods, E - DEG(e*sin(E)) = M with all angles in degrees
+
+#define KEPLER_NEWTON       0       // eccentricAnomaly(), Newton until the correction is below the tolerance.
+#define KEPLER_HALLEY       1       // third order corrections, until the next error is predicted below the tolerance.
+#define KEPLER_FIXED        2       // a fixed number of Newton corrections, chosen for the tolerance at the eccentricity.
+#define KEPLER_TABLE        3       // Newton seeded from a table of E for the eccentricity, for the low e bodies.
+#define KEPLER_MARKLEY      4       // Markley's cubic starter and one fifth order correction, with no iteration.
+#define KEPLER_SOLVERS      5
+
+#define KEPLER_TABLE_SIZE   32      // table intervals over one revolution of M
+
+// type definitions
+
+typedef struct kepler_solver_s {    // a Kepler solver, with its telemetry
+    uint8_t method;
+    uint8_t fixed;          // corrections of KEPLER_FIXED.
+    FLOAT tolerance;        // error accepted in E (deg).
+    FLOAT table[KEPLER_TABLE_SIZE+1];   // E - M at M = k * 360 / KEPLER_TABLE_SIZE (deg), for KEPLER_TABLE.
+    uint32_t calls;         // calls since keplerSolverReset().
+    uint32_t iterations;    // corrections since keplerSolverReset().
+    uint8_t iterationsMax;  // most corrections of any call since keplerSolverReset().
+} kepler_solver_t;
+
+// Kepler solver functions (C)
+
+extern const char * const keplerSolverNames[KEPLER_SOLVERS];
+
+// Prepare a solver for orbits of about eccentricity e, which sets the table and fixed corrections.
+void keplerSolverInit ( kepler_solver_t * solver, uint8_t method, FLOAT e, FLOAT tolerance );
+
+// Zero the telemetry.
+void keplerSolverReset ( kepler_solver_t * solver ) __z88dk_fastcall;
+
+// As eccentricAnomaly(), for M in [0, 360).
+FLOAT keplerSolve ( kepler_solver_t * solver, FLOAT e, FLOAT M ) __z88dk_callee;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_KEPLER_H  */
@@ -2,7 +2,9 @@
 #include <stdint.h>
 #include <math.h>
 
-#include "planets.h"
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
 #include "multi_apu.h"
 
 void sunEclipticCartesianCoordinates ( cartesian_coordinates_t * sun) __z88dk_fastcall
@@ -201,10 +203,11 @@ FLOAT eccentricAnomaly (FLOAT e, FLOAT M) __z88dk_callee
 
     add_0(1.0);
     mul_0(pop_1());
+    deg_0();
     add_0(M);
     E = pop_0();
 
-    // E = M + (e * SIN(RAD(M)) * (1.0 + (e * COS(RAD(M)))));
+    // E = M + DEG(e * SIN(RAD(M)) * (1.0 + (e * COS(RAD(M)))));
 
     do {
         rad_0(E);
@@ -231,7 +234,7 @@ FLOAT eccentricAnomaly (FLOAT e, FLOAT M) __z88dk_callee
         E -= error;
         error = FABS(error);
 
-    } while (error >= 1.0e-3);          // the angle is good enough for our purposes
+    } while (error >= KEPLER_TOLERANCE);    // the angle is good enough for our purposes
 
     return E;
 }
@@ -250,3 +253,49 @@ void addCartesianCoordinates ( cartesian_coordinates_t * base, const cartesian_c
     base->z = pop_2();
 }
 
+
+// The planet_motion_sky.h functions, replacing planet_motion_sky.c and planet_motion_step.c,
+// so that the multi-APU build computes the Sun and every body directly each day on the APUs.
+
+void skyInit ( sky_t * sky, const planet_t * const * planet, uint8_t bodies, FLOAT day, FLOAT step )
+{
+    (void)day;
+    (void)step;
+
+    if (bodies > SKY_BODIES_MAX)
+        bodies = SKY_BODIES_MAX;
+
+    sky->bodies = bodies;
+    sky->planet = planet;
+}
+
+void skyCoordinates ( sky_t * sky, FLOAT day ) __z88dk_callee
+{
+    cartesian_coordinates_t * helio = sky->helio;
+    cartesian_coordinates_t * geo = sky->geo;
+    uint8_t b;
+
+    sky->sun.day = day;
+    sunEclipticCartesianCoordinates(&sky->sun);
+
+    for (b = 0; b < sky->bodies; ++b, ++helio, ++geo) {
+        const planet_t * planet = sky->planet[b];
+
+        if (planet == &sun || planet == &moon) {                    // orbits the Earth
+            geo->day = day;
+            planetEclipticCartesianCoordinates(geo, planet);
+
+            helio->x = geo->x - sky->sun.x;
+            helio->y = geo->y - sky->sun.y;
+            helio->z = geo->z - sky->sun.z;
+            helio->au = geo->au;
+            helio->day = day;
+        } else {
+            helio->day = day;
+            planetEclipticCartesianCoordinates(helio, planet);
+
+            *geo = *helio;
+            addCartesianCoordinates(geo, &sky->sun);
+        }
+    }
+}
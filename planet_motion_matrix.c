@@ -0,0 +1,449 @@
+/*
+ * planet_motion_matrix.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host matrix of the speed and accuracy of each way of computing the bodies.
+
+    build and run with:
+
+    make
+    ./planet_motion_matrix [-s scale] [start_day] [days] [repeat]
+
+    The Sun and the eight bodies are computed for every day by each backend available on the host,
+    and compared with the same formulas evaluated in double, with Kepler's equation solved to 1e-12
+    degrees. For each backend the largest and RMS position error is reported in AU and in pixels,
+    at scale pixels per AU (the Moon 100 times larger, as the animation draws it), with the time
+    per frame of all nine bodies, and then the largest error in pixels of each body.
+
+    The z88dk math48, math32 and am9511 libraries can't run on the host. math32 is IEEE single
+    precision, as the float rows, and the am9511 build is the apu row, planet_motion_mapu.c on
+    the planet_motion_apu.c emulation, where the times are of the emulation, not of the APUs.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_state.h"
+#include "planet_motion_kepler.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+#include "planet_motion_batch.h"
+#include "planet_motion_simd.h"
+#include "planet_motion_cheb.h"
+#include "planet_motion_apu.h"
+#include "planet_motion_fixed.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+#define REPEAT              10
+#define SCALE               48.0                                    // RENDER_SCALE_AU
+#define CHEB_TOLERANCE      1.0e-5                                  // AU
+
+// planet_motion_fns.c with PLANET_MOTION_DEGREES, as built for the host by the Makefile
+
+void degSunEclipticCartesianCoordinates ( cartesian_coordinates_t * sun );
+void degPlanetEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const planet_t * planet );
+
+typedef struct backend_s {
+    const char * name;
+    uint8_t (* run)( const struct backend_s * backend );    // fill frame[][] for the days, returning 0 when not available
+    uint8_t method;
+} backend_t;
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+static uint16_t repeat = REPEAT;
+static double scale = SCALE;
+
+static cartesian_coordinates_t (* frame)[PLANETS];                 // [day][body], the Sun first
+static cartesian_coordinates_t (* reference)[PLANETS];
+
+static cheb_body_t chebBody[PLANETS];
+static cheb_table_t chebTable = { 0, 0, PLANETS, chebBody };
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+static const char * bodyName (uint8_t p)
+{
+    return p == 0 ? "Sun" : planets[p]->name;
+}
+
+// the double precision reference, the formulas of planet_motion_fns.c
+
+static double revDouble (double x)
+{
+    return x - floor(x / 360.0) * 360.0;
+}
+
+static void sunDouble (cartesian_coordinates_t * sun, double day)
+{
+    double T = (day - 1.5) / 36525.0;
+    double L0 = revDouble(280.46645 + (36000.76983 * T) + (0.0003032 * T * T));
+    double M0 = revDouble(357.52910 + (35999.05030 * T) - (0.0001559 * T * T) - (0.00000048 * T * T * T));
+    double C = (1.914600 - 0.004817 * T - 0.000014 * T * T) * sin(RAD(M0)) + (0.01993 - 0.000101 * T) * sin(RAD(2 * M0)) + 0.000290 * sin(RAD(3 * M0));
+    double e = 0.016708617 - T * (0.000042037 + T * 0.0000001236);
+    double r = (1.000001018 * (1 - e * e)) / (1 + e * cos(RAD(M0 + C)));
+
+    sun->x = r * cos(RAD(L0 + C));
+    sun->y = r * sin(RAD(L0 + C));
+    sun->z = 0.0;
+    sun->au = r;
+}
+
+static void planetDouble (cartesian_coordinates_t * location, const planet_t * planet, double day)
+{
+    double N = RAD(planet->N0 + day * (double)planet->Nc);
+    double i = RAD(planet->i0 + day * (double)planet->ic);
+    double w = RAD(planet->w0 + day * (double)planet->wc);
+    double a = planet->a0 + day * (double)planet->ac;
+    double e = planet->e0 + day * (double)planet->ec;
+    double M = RAD(revDouble(planet->M0 + day * (double)planet->Mc));
+    double E = M + e * sin(M) * (1.0 + e * cos(M));
+    double error, xv, yv, r, v;
+    uint8_t k;
+
+    for (k = 0; k < 32; ++k) {
+        error = (E - e * sin(E) - M) / (1 - e * cos(E));
+        E -= error;
+        if (fabs(error) < RAD(1.0e-12))
+            break;
+    }
+
+    xv = a * (cos(E) - e);
+    yv = a * sqrt(1.0 - e * e) * sin(E);
+    v = atan2(yv, xv);
+    r = hypot(xv, yv);
+
+    location->x = r * (cos(N) * cos(v + w) - sin(N) * sin(v + w) * cos(i));
+    location->y = r * (sin(N) * cos(v + w) + cos(N) * sin(v + w) * cos(i));
+    location->z = r * sin(v + w) * sin(i);
+    location->au = r;
+}
+
+// backends
+
+static uint8_t runDouble (const backend_t * backend)
+{
+    uint16_t d;
+    uint8_t p;
+
+    (void)backend;
+    for (d = 0; d < days; ++d) {
+        sunDouble(&frame[d][0], startDay + d);
+        for (p = 1; p < PLANETS; ++p)
+            planetDouble(&frame[d][p], planets[p], startDay + d);
+    }
+    return 1;
+}
+
+static uint8_t runFns (const backend_t * backend)
+{
+    uint16_t d;
+    uint8_t p;
+
+    for (d = 0; d < days; ++d) {
+        for (p = 0; p < PLANETS; ++p)
+            frame[d][p].day = startDay + d;
+        if (backend->method) {
+            degSunEclipticCartesianCoordinates(&frame[d][0]);
+            for (p = 1; p < PLANETS; ++p)
+                degPlanetEclipticCartesianCoordinates(&frame[d][p], planets[p]);
+        } else {
+            sunEclipticCartesianCoordinates(&frame[d][0]);
+            for (p = 1; p < PLANETS; ++p)
+                planetEclipticCartesianCoordinates(&frame[d][p], planets[p]);
+        }
+    }
+    return 1;
+}
+
+static uint8_t runState (const backend_t * backend)
+{
+    planet_state_t state[PLANETS];
+    kepler_solver_t solver[PLANETS];
+    uint16_t d;
+    uint8_t p;
+
+    for (p = 1; p < PLANETS; ++p) {
+        planetStateInit(&state[p], planets[p], PLANET_STATE_TOLERANCE);
+        keplerSolverInit(&solver[p], backend->method, planets[p]->e0, KEPLER_TOLERANCE);
+        state[p].solver = &solver[p];
+    }
+    for (d = 0; d < days; ++d) {
+        frame[d][0].day = startDay + d;
+        sunEclipticCartesianCoordinates(&frame[d][0]);
+        for (p = 1; p < PLANETS; ++p) {
+            frame[d][p].day = startDay + d;
+            planetStateEclipticCartesianCoordinates(&frame[d][p], &state[p]);
+        }
+    }
+    return 1;
+}
+
+static uint8_t runStepper (const backend_t * backend)
+{
+    sun_stepper_t sunStepper;
+    planet_stepper_t stepper[PLANETS];
+    uint16_t d;
+    uint8_t p;
+
+    (void)backend;
+    sunStepperInit(&sunStepper, startDay, 1.0, STEPPER_RENORMALISE);
+    for (p = 1; p < PLANETS; ++p)
+        planetStepperInit(&stepper[p], planets[p], startDay, 1.0, STEPPER_RENORMALISE);
+
+    for (d = 0; d < days; ++d) {
+        frame[d][0].day = startDay + d;
+        sunStepperEclipticCartesianCoordinates(&frame[d][0], &sunStepper);
+        for (p = 1; p < PLANETS; ++p) {
+            frame[d][p].day = startDay + d;
+            planetStepperEclipticCartesianCoordinates(&frame[d][p], &stepper[p]);
+        }
+    }
+    return 1;
+}
+
+static uint8_t runBatch (const backend_t * backend)
+{
+    static const simd_kernels_t * const kernels[] = {
+        &simdScalar,
+#if defined(__x86_64__)
+        &simdSSE2, &simdAVX2,
+#endif
+        NULL, NULL };
+    cartesian_table_t table;
+    uint32_t k;
+    uint16_t d;
+    uint8_t p;
+
+    if (kernels[backend->method] == NULL || !simdSelect(kernels[backend->method]))
+        return 0;
+
+    table.x = malloc((uint32_t)PLANETS * days * sizeof(FLOAT));
+    table.y = malloc((uint32_t)PLANETS * days * sizeof(FLOAT));
+    table.z = malloc((uint32_t)PLANETS * days * sizeof(FLOAT));
+    table.au = malloc((uint32_t)PLANETS * days * sizeof(FLOAT));
+
+    sunEclipticCartesianBatch(&table, startDay, days);              // the Sun in row 0, then the planets
+    planetEclipticCartesianBatch(&(cartesian_table_t){ table.x + days, table.y + days, table.z + days, table.au + days },
+                                 &planets[1], PLANETS - 1, startDay, days);
+
+    for (p = 0; p < PLANETS; ++p) {
+        for (d = 0; d < days; ++d) {
+            k = (uint32_t)p * days + d;
+            frame[d][p].x = table.x[k];
+            frame[d][p].y = table.y[k];
+            frame[d][p].z = table.z[k];
+            frame[d][p].au = table.au[k];
+        }
+    }
+
+    free(table.x);
+    free(table.y);
+    free(table.z);
+    free(table.au);
+    simdSelect(&simdScalar);
+    return 1;
+}
+
+static uint8_t runCheb (const backend_t * backend)
+{
+    uint16_t d;
+    uint8_t p;
+
+    (void)backend;
+    for (d = 0; d < days; ++d) {
+        for (p = 0; p < PLANETS; ++p) {
+            frame[d][p].day = startDay + d;
+            chebEclipticCartesianCoordinates(&frame[d][p], &chebTable, p);
+        }
+    }
+    return 1;
+}
+
+static uint8_t runFixed (const backend_t * backend)
+{
+    uint16_t d;
+    uint8_t p;
+
+    (void)backend;
+    for (d = 0; d < days; ++d) {
+        frame[d][0].day = startDay + d;
+        fixSunEclipticCartesianCoordinates(&frame[d][0]);
+        for (p = 1; p < PLANETS; ++p) {
+            frame[d][p].day = startDay + d;
+            fixPlanetEclipticCartesianCoordinates(&frame[d][p], planets[p]);
+        }
+    }
+    return 1;
+}
+
+static uint8_t runApu (const backend_t * backend)
+{
+    uint16_t d;
+    uint8_t p;
+
+    (void)backend;
+    apuReset();
+    for (d = 0; d < days; ++d) {
+        frame[d][0].day = startDay + d;
+        apuSunEclipticCartesianCoordinates(&frame[d][0]);
+        for (p = 1; p < PLANETS; ++p) {
+            frame[d][p].day = startDay + d;
+            apuPlanetEclipticCartesianCoordinates(&frame[d][p], planets[p]);
+        }
+    }
+    return 1;
+}
+
+static const backend_t backends[] = {
+    { "double",             runDouble,  0 },
+    { "float",              runFns,     0 },
+    { "float degrees",      runFns,     1 },
+    { "state newton",       runState,   KEPLER_NEWTON },
+    { "state halley",       runState,   KEPLER_HALLEY },
+    { "state fixed",        runState,   KEPLER_FIXED },
+    { "state table",        runState,   KEPLER_TABLE },
+    { "state markley",      runState,   KEPLER_MARKLEY },
+    { "steppers",           runStepper, 0 },
+    { "batch scalar",       runBatch,   0 },
+    { "batch sse2",         runBatch,   1 },
+    { "batch avx2",         runBatch,   2 },
+    { "chebyshev",          runCheb,    0 },
+    { "fixed point",        runFixed,   0 },
+    { "apu",                runApu,     0 },
+};
+
+#define BACKENDS            (sizeof(backends)/sizeof(backends[0]))
+
+static double bodyMax[BACKENDS][PLANETS];                           // pixels
+
+int main (int argc, char ** argv)
+{
+    double error, errorMax, errorSum, pixelMax, pixelSum, start, elapsed;
+    uint16_t d, r;
+    uint8_t b, p;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:")) != -1) {
+        switch (opt) {
+            case 's': scale = atof(optarg); break;
+            default: scale = 0.0; break;
+        }
+    }
+    if (optind < argc) startDay = (uint16_t)atoi(argv[optind]);
+    if (optind + 1 < argc) days = (uint16_t)atoi(argv[optind + 1]);
+    if (optind + 2 < argc) repeat = (uint16_t)atoi(argv[optind + 2]);
+    if (optind + 3 < argc || days == 0 || repeat == 0 || scale <= 0.0) {
+        fprintf(stderr, "usage: %s [-s scale] [start_day] [days] [repeat]\n", argv[0]);
+        return 1;
+    }
+
+    frame = malloc(days * sizeof(*frame));
+    reference = malloc(days * sizeof(*reference));
+
+    for (d = 0; d < days; ++d) {
+        sunDouble(&reference[d][0], startDay + d);
+        for (p = 1; p < PLANETS; ++p)
+            planetDouble(&reference[d][p], planets[p], startDay + d);
+    }
+
+    chebTable.start = startDay;
+    chebTable.days = days;
+    for (p = 0; p < PLANETS; ++p)
+        chebFit(&chebBody[p], p == 0 ? NULL : planets[p], startDay, days, CHEB_TOLERANCE);
+
+    printf("%u days from day %u, at %.1f pixels per AU, the Moon at %.1f, against double\n\n", days, startDay, scale, 100.0 * scale);
+    printf("%-16s %10s %10s %10s %10s %12s\n", "backend", "max AU", "rms AU", "max px", "rms px", "ns/frame");
+
+    for (b = 0; b < BACKENDS; ++b) {
+        start = now();
+        for (r = 0; r < repeat; ++r) {
+            if (!backends[b].run(&backends[b]))
+                break;
+        }
+        elapsed = now() - start;
+        if (r < repeat) {
+            printf("%-16s %10s\n", backends[b].name, "n/a");
+            bodyMax[b][0] = -1.0;
+            continue;
+        }
+
+        errorMax = errorSum = pixelMax = pixelSum = 0.0;
+        for (d = 0; d < days; ++d) {
+            for (p = 0; p < PLANETS; ++p) {
+                error = sqrt((frame[d][p].x - reference[d][p].x) * (frame[d][p].x - reference[d][p].x) +
+                             (frame[d][p].y - reference[d][p].y) * (frame[d][p].y - reference[d][p].y) +
+                             (frame[d][p].z - reference[d][p].z) * (frame[d][p].z - reference[d][p].z));
+                if (error > errorMax)
+                    errorMax = error;
+                errorSum += error * error;
+
+                error *= (planets[p] == &moon) ? 100.0 * scale : scale;
+                if (error > pixelMax)
+                    pixelMax = error;
+                if (error > bodyMax[b][p])
+                    bodyMax[b][p] = error;
+                pixelSum += error * error;
+            }
+        }
+
+        printf("%-16s %10.2e %10.2e %10.4f %10.4f %12.1f\n", backends[b].name, errorMax, sqrt(errorSum / (days * PLANETS)),
+               pixelMax, sqrt(pixelSum / (days * PLANETS)), elapsed * 1.0e9 / ((double)repeat * days));
+    }
+
+    printf("\nmax px of each body\n%-16s", "backend");
+    for (p = 0; p < PLANETS; ++p)
+        printf(" %8.8s", bodyName(p));
+    printf("\n");
+    for (b = 0; b < BACKENDS; ++b) {
+        if (bodyMax[b][0] < 0.0)
+            continue;
+        printf("%-16s", backends[b].name);
+        for (p = 0; p < PLANETS; ++p)
+            printf(" %8.4f", bodyMax[b][p]);
+        printf("\n");
+    }
+
+    for (p = 0; p < PLANETS; ++p)
+        chebFree(&chebBody[p]);
+    free(frame);
+    free(reference);
+    return 0;
+}
@@ -0,0 +1,214 @@
+/*
+ * planet_motion_parallel_gen.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host parallel generation of the Sun and planets over a long range of days.
+
+    build and run with:
+
+    make
+    ./planet_motion_parallel_gen [-t threads] [-c chunk_days] [-s] [-o file] [start_day] [days]
+
+    The days are split into chunks, which a work stealing pool of threads computes with the batch
+    functions, and the chunks are written in day order as they complete, holding no more than four
+    chunks per thread in memory. Each day is written as x, y, z and au FLOATs of the Sun then the
+    planets, in the order of planets[], to the file, by default /dev/null.
+
+    With -s the range is also run on 1, 2, 4 ... threads, to show the scaling.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "planet_motion.h"
+#include "planet_motion_batch.h"
+#include "planet_motion_simd.h"
+#include "planet_motion_pool.h"
+
+#define START_DAY           -182621                                 // January 1st, 1500
+#define DAYS                365242                                  // a thousand years
+#define CHUNK_DAYS          1024
+#define WINDOW_PER_THREAD   4
+#define WRITE_BUFFER        (1 << 20)
+
+typedef struct gen_s {
+    int32_t start;
+    uint32_t days;
+    uint16_t chunkDays;
+    FLOAT * slot;           // window chunks of day records.
+    FLOAT * scratch;        // per worker, 4 arrays of PLANETS rows of chunkDays.
+    FILE * fp;
+} gen_t;
+
+static pool_t pool;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static uint16_t chunkLength (const gen_t * gen, uint32_t task)
+{
+    uint32_t first = task * gen->chunkDays;
+
+    return (gen->days - first < gen->chunkDays) ? (uint16_t)(gen->days - first) : gen->chunkDays;
+}
+
+static void run (void * context, uint32_t task, uint32_t slot, uint16_t worker)
+{
+    gen_t * gen = context;
+    uint16_t n = chunkLength(gen, task);
+    uint32_t rows = (uint32_t)PLANETS * n;
+    FLOAT * x = gen->scratch + (size_t)worker * 4 * PLANETS * gen->chunkDays;
+    FLOAT * out = gen->slot + (size_t)slot * PLANETS * 4 * gen->chunkDays;
+    cartesian_table_t sun = { x, x + rows, x + 2*rows, x + 3*rows };
+    cartesian_table_t table = { x + n, x + rows + n, x + 2*rows + n, x + 3*rows + n };
+    FLOAT day = (FLOAT)(gen->start + (int32_t)(task * gen->chunkDays));
+    uint16_t d;
+    uint8_t b;
+
+    sunEclipticCartesianBatch(&sun, day, n);
+    planetEclipticCartesianBatch(&table, &planets[1], PLANETS-1, day, n);
+
+    for (d = 0; d < n; ++d) {                                       // rows of bodies, to records of days
+        for (b = 0; b < PLANETS; ++b) {
+            *out++ = sun.x[b * n + d];
+            *out++ = sun.y[b * n + d];
+            *out++ = sun.z[b * n + d];
+            *out++ = sun.au[b * n + d];
+        }
+    }
+}
+
+static void emit (void * context, uint32_t task, uint32_t slot)
+{
+    gen_t * gen = context;
+
+    if (gen->fp)
+        fwrite(gen->slot + (size_t)slot * PLANETS * 4 * gen->chunkDays, sizeof(FLOAT) * PLANETS * 4, chunkLength(gen, task), gen->fp);
+}
+
+// generate the days on threads, returning the seconds taken, or 0 on failure
+static double generate (gen_t * gen, uint16_t threads)
+{
+    uint32_t tasks = (gen->days + gen->chunkDays - 1) / gen->chunkDays;
+    uint32_t window = threads * WINDOW_PER_THREAD;
+    double start;
+    uint8_t status;
+
+    gen->slot = malloc((size_t)window * PLANETS * 4 * gen->chunkDays * sizeof(FLOAT));
+    gen->scratch = malloc((size_t)threads * 4 * PLANETS * gen->chunkDays * sizeof(FLOAT));
+    if (gen->slot == NULL || gen->scratch == NULL) {
+        free(gen->slot);
+        free(gen->scratch);
+        return 0.0;
+    }
+
+    start = now();
+    status = poolRun(&pool, threads, tasks, window, run, emit, gen);
+    if (gen->fp)
+        fflush(gen->fp);
+    start = now() - start;
+
+    free(gen->slot);
+    free(gen->scratch);
+    return status ? start / 1.0e9 : 0.0;
+}
+
+int main (int argc, char ** argv)
+{
+    const char * file = "/dev/null";
+    gen_t gen = { START_DAY, DAYS, CHUNK_DAYS, NULL, NULL, NULL };
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint16_t threads = cpus > 0 ? (cpus < POOL_WORKERS_MAX ? (uint16_t)cpus : POOL_WORKERS_MAX) : 1;
+    uint16_t t, w;
+    uint32_t steals = 0;
+    uint8_t scaling = 0;
+    double seconds, single = 0.0;
+    int k;
+
+    for (k = 1; k < argc && argv[k][0] == '-' && argv[k][1] != '\0' && (argv[k][1] < '0' || argv[k][1] > '9'); ++k) {
+        if (strcmp(argv[k], "-t") == 0 && k + 1 < argc) {
+            threads = (uint16_t)atoi(argv[++k]);
+        } else if (strcmp(argv[k], "-c") == 0 && k + 1 < argc) {
+            gen.chunkDays = (uint16_t)atoi(argv[++k]);
+        } else if (strcmp(argv[k], "-o") == 0 && k + 1 < argc) {
+            file = argv[++k];
+        } else if (strcmp(argv[k], "-s") == 0) {
+            scaling = 1;
+        } else {
+            break;
+        }
+    }
+    if (k < argc) gen.start = (int32_t)atol(argv[k++]);
+    if (k < argc) gen.days = (uint32_t)atol(argv[k++]);
+    if (k < argc || gen.days == 0 || gen.chunkDays == 0 || threads == 0 || threads > POOL_WORKERS_MAX) {
+        fprintf(stderr, "usage: %s [-t threads] [-c chunk_days] [-s] [-o file] [start_day] [days]\n", argv[0]);
+        return 1;
+    }
+
+    simdKernels();                                                  // select the kernels before the threads start
+
+    printf("%u days from day %d in chunks of %u, %s kernels, %ld cpus\n\n", gen.days, gen.start, gen.chunkDays, simdKernels()->name, cpus);
+    printf("%8s %10s %14s %14s %8s\n", "threads", "seconds", "days/sec", "body-days/sec", "speedup");
+
+    for (t = scaling ? 1 : threads; t <= threads; t = (t * 2 > threads && t < threads) ? threads : t * 2) {
+        if ((gen.fp = fopen(file, "wb")) == NULL) {
+            perror(file);
+            return 1;
+        }
+        setvbuf(gen.fp, NULL, _IOFBF, WRITE_BUFFER);
+
+        seconds = generate(&gen, t);
+        fclose(gen.fp);
+        if (seconds == 0.0) {
+            fprintf(stderr, "cannot run %u threads\n", t);
+            return 1;
+        }
+        if (t == 1)
+            single = seconds;
+
+        printf("%8u %10.3f %14.0f %14.0f", t, seconds, gen.days / seconds, gen.days * (double)PLANETS / seconds);
+        if (single > 0.0)
+            printf(" %8.2f", single / seconds);
+        printf("\n");
+    }
+
+    for (w = 0; w < pool.workers; ++w)
+        steals += pool.deque[w].steals;
+    printf("\n%u chunks, %u stolen by %u threads\n", (gen.days + gen.chunkDays - 1) / gen.chunkDays, steals, pool.workers);
+    return 0;
+}
@@ -0,0 +1,249 @@
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_perturb.h"
+
+// Schlyter's terms are sines and cosines of sums of small multiples of a few angles, the mean
+// anomalies, and for the Moon its elongation D and argument of latitude F. The sine and cosine of
+// each angle is found once, its multiples by the angle sum identities, and each term is the product
+// of the multiples it needs, so a term costs a few multiplications rather than a sine.
+// Each term's phase is folded into its two coefficients, and the terms are in order of level.
+//
+// The corrections are small angles, so they are applied as rotations by their Taylor series,
+// about the ecliptic pole for the longitude, and towards it for the latitude.
+
+#define PERTURB_MULTIPLE_MAX    6           // the largest multiple of an argument, 6 Ms of Saturn
+
+typedef struct perturb_series_s {
+    const perturb_term_t * term;
+    uint8_t terms;
+} perturb_series_t;
+
+typedef struct perturb_body_s {
+    const planet_t * planet;
+    perturb_series_t longitude;
+    perturb_series_t latitude;
+    perturb_series_t distance;              // in Earth radii
+} perturb_body_t;
+
+// Moon, of Mm, D, F and the Sun's Ms
+
+static const perturb_term_t moonLongitude[] = {
+    { 1, {  1, -2,  0,  0 },  -1.274000,   0.000000 },   // -1.274 sin(Mm - 2D), evection
+    { 1, {  0,  2,  0,  0 },   0.658000,   0.000000 },   // +0.658 sin(2D), variation
+    { 1, {  0,  0,  0,  1 },  -0.186000,   0.000000 },   // -0.186 sin(Ms), yearly equation
+    { 2, {  2, -2,  0,  0 },  -0.059000,   0.000000 },   // -0.059 sin(2Mm - 2D)
+    { 2, {  1, -2,  0,  1 },  -0.057000,   0.000000 },   // -0.057 sin(Mm - 2D + Ms)
+    { 2, {  1,  2,  0,  0 },   0.053000,   0.000000 },   // +0.053 sin(Mm + 2D)
+    { 2, {  0,  2,  0, -1 },   0.046000,   0.000000 },   // +0.046 sin(2D - Ms)
+    { 2, {  1,  0,  0, -1 },   0.041000,   0.000000 },   // +0.041 sin(Mm - Ms)
+    { 2, {  0,  1,  0,  0 },  -0.035000,   0.000000 },   // -0.035 sin(D), parallactic equation
+    { 2, {  1,  0,  0,  1 },  -0.031000,   0.000000 },   // -0.031 sin(Mm + Ms)
+    { 2, {  0, -2,  2,  0 },  -0.015000,   0.000000 },   // -0.015 sin(2F - 2D)
+    { 2, {  1, -4,  0,  0 },   0.011000,   0.000000 },   // +0.011 sin(Mm - 4D)
+};
+
+static const perturb_term_t moonLatitude[] = {
+    { 1, {  0, -2,  1,  0 },  -0.173000,   0.000000 },   // -0.173 sin(F - 2D)
+    { 2, {  1, -2, -1,  0 },  -0.055000,   0.000000 },   // -0.055 sin(Mm - F - 2D)
+    { 2, {  1, -2,  1,  0 },  -0.046000,   0.000000 },   // -0.046 sin(Mm + F - 2D)
+    { 2, {  0,  2,  1,  0 },   0.033000,   0.000000 },   // +0.033 sin(F + 2D)
+    { 2, {  2,  0,  1,  0 },   0.017000,   0.000000 },   // +0.017 sin(2Mm + F)
+};
+
+static const perturb_term_t moonDistance[] = {
+    { 1, {  1, -2,  0,  0 },   0.000000,  -0.580000 },   // -0.58 cos(Mm - 2D), Earth radii
+    { 1, {  0,  2,  0,  0 },   0.000000,  -0.460000 },   // -0.46 cos(2D)
+};
+
+// Jupiter, Saturn and Uranus, of Mj, Ms and Mu
+
+static const perturb_term_t jupiterLongitude[] = {
+    { 1, {  2, -5,  0,  0 },  -0.126515,   0.306949 },   // -0.332 sin(2Mj - 5Ms - 67.6), the great inequality
+    { 2, {  2, -2,  0,  0 },  -0.052281,  -0.020069 },   // -0.056 sin(2Mj - 2Ms + 21)
+    { 2, {  3, -5,  0,  0 },   0.039210,   0.015051 },   // +0.042 sin(3Mj - 5Ms + 21)
+    { 2, {  1, -2,  0,  0 },  -0.036000,   0.000000 },   // -0.036 sin(Mj - 2Ms)
+    { 2, {  2, -3,  0,  0 },   0.014160,   0.018124 },   // +0.023 sin(2Mj - 3Ms + 52)
+    { 2, {  1, -1,  0,  0 },   0.000000,   0.022000 },   // +0.022 cos(Mj - Ms)
+    { 2, {  1, -5,  0,  0 },  -0.005734,   0.014937 },   // -0.016 sin(Mj - 5Ms - 69)
+};
+
+static const perturb_term_t saturnLongitude[] = {
+    { 1, {  2, -5,  0,  0 },   0.309429,  -0.750731 },   // +0.812 sin(2Mj - 5Ms - 67.6), the great inequality
+    { 1, {  2, -4,  0,  0 },  -0.007992,  -0.228860 },   // -0.229 cos(2Mj - 4Ms - 2)
+    { 1, {  1, -2,  0,  0 },   0.118837,  -0.006228 },   // +0.119 sin(Mj - 2Ms - 3)
+    { 2, {  2, -6,  0,  0 },   0.016485,  -0.042945 },   // +0.046 sin(2Mj - 6Ms - 69)
+    { 2, {  1, -3,  0,  0 },   0.011873,   0.007419 },   // +0.014 sin(Mj - 3Ms + 32)
+};
+
+static const perturb_term_t saturnLatitude[] = {
+    { 2, {  2, -4,  0,  0 },  -0.000698,  -0.019988 },   // -0.020 cos(2Mj - 4Ms - 2)
+    { 2, {  2, -6,  0,  0 },   0.011809,  -0.013585 },   // +0.018 sin(2Mj - 6Ms - 49)
+};
+
+static const perturb_term_t uranusLongitude[] = {
+    { 2, {  0,  1, -2,  0 },   0.039781,   0.004181 },   // +0.040 sin(Ms - 2Mu + 6)
+    { 2, {  0,  1, -3,  0 },   0.029353,   0.019062 },   // +0.035 sin(Ms - 3Mu + 33)
+    { 2, {  1,  0, -1,  0 },  -0.014095,  -0.005130 },   // -0.015 sin(Mj - Mu + 20)
+};
+
+#define SERIES(t)   { (t), sizeof(t)/sizeof(t[0]) }
+#define NONE        { NULL, 0 }
+
+static const perturb_body_t bodies[] = {
+    { &moon,    SERIES(moonLongitude),    SERIES(moonLatitude),   SERIES(moonDistance) },
+    { &jupiter, SERIES(jupiterLongitude), NONE,                   NONE },
+    { &saturn,  SERIES(saturnLongitude),  SERIES(saturnLatitude), NONE },
+    { &uranus,  SERIES(uranusLongitude),  NONE,                   NONE },
+};
+
+static FLOAT meanAnomaly (const planet_t * planet, FLOAT day)
+{
+    return rev( planet->M0 + (day * planet->Mc) );
+}
+
+// the largest multiple of each argument in the terms of series up to level, and the terms
+static uint8_t multiples (uint8_t * most, const perturb_series_t * series, uint8_t level)
+{
+    uint8_t t, j, k;
+
+    for (t = 0; t < series->terms && series->term[t].level <= level; ++t) {
+        for (j = 0; j < PERTURB_ARGUMENTS; ++j) {
+            k = (uint8_t)(series->term[t].k[j] < 0 ? -series->term[t].k[j] : series->term[t].k[j]);
+            if (k > most[j])
+                most[j] = k;
+        }
+    }
+    return t;
+}
+
+// the terms of series up to level, from the sines and cosines of the multiples of the arguments
+static FLOAT evaluate (const perturb_series_t * series, uint8_t level, FLOAT (* s)[PERTURB_MULTIPLE_MAX + 1], FLOAT (* c)[PERTURB_MULTIPLE_MAX + 1])
+{
+    FLOAT sum = 0.0;
+    uint8_t t, j;
+
+    for (t = 0; t < series->terms && series->term[t].level <= level; ++t) {
+        const perturb_term_t * term = &series->term[t];
+        FLOAT sinA = 0.0, cosA = 1.0;
+
+        for (j = 0; j < PERTURB_ARGUMENTS; ++j) {
+            int8_t k = term->k[j];
+            FLOAT sk, ck, sn;
+
+            if (k == 0)
+                continue;
+            sk = (k > 0) ? s[j][k] : -s[j][-k];
+            ck = (k > 0) ? c[j][k] : c[j][-k];
+            sn = sinA * ck + cosA * sk;
+            cosA = cosA * ck - sinA * sk;
+            sinA = sn;
+        }
+        sum += term->s * sinA + term->c * cosA;
+    }
+    return sum;
+}
+
+uint8_t planetPerturbations ( perturbation_t * perturbation, const planet_t * planet, FLOAT day, uint8_t level )
+{
+    const perturb_body_t * body = NULL;
+    FLOAT argument[PERTURB_ARGUMENTS];
+    FLOAT s[PERTURB_ARGUMENTS][PERTURB_MULTIPLE_MAX + 1];
+    FLOAT c[PERTURB_ARGUMENTS][PERTURB_MULTIPLE_MAX + 1];
+    uint8_t most[PERTURB_ARGUMENTS] = { 0 };
+    uint8_t terms, j, m;
+
+    perturbation->longitude = 0.0;
+    perturbation->latitude = 0.0;
+    perturbation->distance = 0.0;
+
+    if (level == PERTURB_KEPLER)
+        return 0;
+
+    for (j = 0; j < sizeof(bodies)/sizeof(bodies[0]); ++j) {
+        if (bodies[j].planet == planet)
+            body = &bodies[j];
+    }
+    if (body == NULL)
+        return 0;
+
+    terms = multiples(most, &body->longitude, level);
+    terms += multiples(most, &body->latitude, level);
+    terms += multiples(most, &body->distance, level);
+
+    if (planet == &moon) {
+        FLOAT Ms = meanAnomaly(&sun, day);
+        FLOAT Ls = Ms + sun.w0 + (day * sun.wc);                    // mean longitudes of the Sun and Moon
+        FLOAT Nm = moon.N0 + (day * moon.Nc);
+        FLOAT Lm = meanAnomaly(&moon, day) + moon.w0 + (day * moon.wc) + Nm;
+
+        argument[0] = meanAnomaly(&moon, day);
+        argument[1] = rev(Lm - Ls);                                 // D, the mean elongation
+        argument[2] = rev(Lm - Nm);                                 // F, the argument of latitude
+        argument[3] = Ms;
+    } else {
+        argument[0] = meanAnomaly(&jupiter, day);
+        argument[1] = meanAnomaly(&saturn, day);
+        argument[2] = meanAnomaly(&uranus, day);
+        argument[3] = 0.0;
+    }
+
+    for (j = 0; j < PERTURB_ARGUMENTS; ++j) {                       // only the multiples the terms need
+        s[j][0] = 0.0;
+        c[j][0] = 1.0;
+        if (most[j] == 0)
+            continue;
+        SINCOSD(argument[j], &s[j][1], &c[j][1]);
+        for (m = 2; m <= most[j]; ++m) {
+            s[j][m] = s[j][m-1] * c[j][1] + c[j][m-1] * s[j][1];
+            c[j][m] = c[j][m-1] * c[j][1] - s[j][m-1] * s[j][1];
+        }
+    }
+
+    perturbation->longitude = evaluate(&body->longitude, level, s, c);
+    perturbation->latitude = evaluate(&body->latitude, level, s, c);
+    perturbation->distance = evaluate(&body->distance, level, s, c) * (FLOAT)(1.0/EARTH_RADII_PER_ASTRONOMICAL_UNIT);
+
+    return terms;
+}
+
+// sin and cos of a small angle x in degrees, by Taylor series (error < 1e-9 for |x| <= 2)
+static void sincosSmall (FLOAT x, FLOAT * s, FLOAT * c)
+{
+    FLOAT r = RAD(x);
+    FLOAT r2 = r * r;
+
+    *s = r * (1.0 - r2 * (1.0/6.0));
+    *c = 1.0 - r2 * 0.5 * (1.0 - r2 * (1.0/12.0));
+}
+
+void planetPerturbedEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const planet_t * planet, uint8_t level ) __z88dk_callee
+{
+    perturbation_t p;
+    FLOAT x, y, z, rho, sinL, cosL, sinB, cosB, k;
+
+    planetEclipticCartesianCoordinates(location, planet);
+
+    if (planetPerturbations(&p, planet, location->day, level) == 0)
+        return;
+
+    // rotate about the ecliptic pole by the longitude
+    sincosSmall(p.longitude, &sinL, &cosL);
+    x = location->x * cosL - location->y * sinL;
+    y = location->x * sinL + location->y * cosL;
+    z = location->z;
+
+    // and towards it by the latitude, with the distance
+    sincosSmall(p.latitude, &sinB, &cosB);
+    rho = HYPOT(x, y);
+    k = (location->au + p.distance) / location->au;
+
+    location->z = (z * cosB + rho * sinB) * k;
+    k *= (rho * cosB - z * sinB) / rho;
+    location->x = x * k;
+    location->y = y * k;
+    location->au += p.distance;
+}
@@ -0,0 +1,77 @@
+/*
+ * planet_motion_perturb.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_PERTURB_H
+#define _PLANET_MOTION_PERTURB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Accuracy levels, each adding terms of the perturbation series of http://www.stjarnhimlen.se/comp/ppcomp.html#9
+// to the unperturbed Kepler orbits. Only the Moon, Jupiter, Saturn and Uranus have terms.
+
+#define PERTURB_KEPLER      0               // unperturbed, as planetEclipticCartesianCoordinates().
+#define PERTURB_MAJOR       1               // terms of 0.1 degree or more, the great inequality of Jupiter and Saturn,
+                                            // and the Moon's evection, variation and yearly equation, with its largest
+                                            // latitude and distance terms.
+#define PERTURB_FULL        2               // every term, to about 0.01 degree, with Uranus.
+
+#define PERTURB_LEVELS      3
+
+#define PERTURB_ARGUMENTS   4               // angles the terms are sums of multiples of.
+
+// type definitions
+
+typedef struct perturbation_s {     // corrections to the position in its orbit
+    FLOAT longitude;        // ecliptic longitude (deg).
+    FLOAT latitude;         // ecliptic latitude (deg).
+    FLOAT distance;         // distance from the thing it is orbiting (AU).
+} perturbation_t;
+
+typedef struct perturb_term_s {     // s sin(A) + c cos(A), where A is the sum of k multiples of the arguments
+    uint8_t level;
+    int8_t k[PERTURB_ARGUMENTS];
+    FLOAT s, c;             // the coefficient times the cosine and sine of the term's phase.
+} perturb_term_t;
+
+// perturbation functions (C)
+
+// The corrections to planet for day, from its terms up to level, evaluated only when it has some.
+// The sines and cosines of the multiples of the arguments are shared by every term.
+// Returns the number of terms evaluated.
+uint8_t planetPerturbations ( perturbation_t * perturbation, const planet_t * planet, FLOAT day, uint8_t level );
+
+// As planetEclipticCartesianCoordinates(), with the perturbations of planet up to level.
+void planetPerturbedEclipticCartesianCoordinates ( cartesian_coordinates_t * location, const planet_t * planet, uint8_t level ) __z88dk_callee;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_PERTURB_H  */
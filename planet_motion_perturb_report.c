@@ -0,0 +1,145 @@
+/*
+ * planet_motion_perturb_report.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host report of the cost and size of each accuracy level of the perturbations.
+
+    build and run with:
+
+    make
+    ./planet_motion_perturb_report [start_day] [days] [repeat]
+
+    Every body is solved for every day at each level, reporting the terms evaluated, the time per
+    frame, and the largest shift from the unperturbed orbit, in degrees as seen from the thing it
+    orbits, and in pixels at the animation's scale. Bodies without terms cost the same at every level.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_perturb.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+#define REPEAT              64
+#define SCALE               48.0                                    // RENDER_SCALE_AU
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+static uint16_t repeat = REPEAT;
+
+static volatile FLOAT sink;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+static double scale (uint8_t p)
+{
+    return (planets[p] == &moon) ? 100.0 * SCALE : SCALE;
+}
+
+// the time per frame of body p at level, in ns
+static double cost (uint8_t p, uint8_t level)
+{
+    cartesian_coordinates_t location;
+    uint16_t r, d;
+    double t = now();
+
+    for (r = 0; r < repeat; ++r) {
+        for (d = 0; d < days; ++d) {
+            location.day = startDay + d;
+            planetPerturbedEclipticCartesianCoordinates(&location, planets[p], level);
+            sink = location.x;
+        }
+    }
+    return (now() - t) * 1.0e9 / ((double)repeat * days);
+}
+
+int main (int argc, char ** argv)
+{
+    const char * const levels[PERTURB_LEVELS] = { "kepler", "major", "full" };
+    double total[PERTURB_LEVELS] = { 0.0 };
+    uint8_t p, level;
+
+    if (argc > 1) startDay = (uint16_t)atoi(argv[1]);
+    if (argc > 2) days = (uint16_t)atoi(argv[2]);
+    if (argc > 3) repeat = (uint16_t)atoi(argv[3]);
+    if (days == 0 || repeat == 0) {
+        fprintf(stderr, "usage: %s [start_day] [days] [repeat]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%u days from day %u, %u repeats\n\n", days, startDay, repeat);
+    printf("%-8s %-8s %6s %10s %12s %10s\n", "level", "body", "terms", "ns/frame", "shift (deg)", "shift (px)");
+
+    for (level = 0; level < PERTURB_LEVELS; ++level) {
+        for (p = 0; p < PLANETS; ++p) {
+            perturbation_t perturbation;
+            cartesian_coordinates_t kepler, location;
+            double worst = 0.0, px = 0.0, ns;
+            uint8_t terms = planetPerturbations(&perturbation, planets[p], startDay, level);
+            uint16_t d;
+
+            for (d = 0; d < days; ++d) {
+                double dx, dy, dz, angle;
+
+                kepler.day = location.day = startDay + d;
+                planetEclipticCartesianCoordinates(&kepler, planets[p]);
+                planetPerturbedEclipticCartesianCoordinates(&location, planets[p], level);
+
+                dx = location.x - kepler.x;
+                dy = location.y - kepler.y;
+                dz = location.z - kepler.z;
+                angle = DEG(sqrt(dx * dx + dy * dy + dz * dz) / kepler.au);
+                if (angle > worst)
+                    worst = angle;
+                if (sqrt(dx * dx + dy * dy) * scale(p) > px)
+                    px = sqrt(dx * dx + dy * dy) * scale(p);
+            }
+
+            ns = cost(p, level);
+            total[level] += ns;
+            if (terms > 0 || level == PERTURB_KEPLER)
+                printf("%-8s %-8s %6u %10.1f %12.4f %10.2f\n", levels[level], planets[p]->name, terms, ns, worst, px);
+        }
+    }
+
+    printf("\nevery body, per frame:");
+    for (level = 0; level < PERTURB_LEVELS; ++level)
+        printf("  %s %.1f ns", levels[level], total[level]);
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,352 @@
+/*
+ * planet_motion_pipeline.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host pipelined animation: compute, ReGIS encoding and output on their own threads.
+
+    build and run with:
+
+    make
+    ./planet_motion_pipeline [-b baud] [-o file] [start_day] [days]
+
+    A propagation thread steps the sky one day at a time into a ring of day records, an encoder
+    thread draws each as a ReGIS frame into a ring of frame buffers, and the main thread gathers
+    frames into large writes to the file, by default /dev/null, or stdout for "-". The same frames
+    are first made in sequence, as the animation does, writing each frame as it is drawn, to
+    /dev/null at the same pace, so that the file holds the animation once.
+
+    With -b each write is held to the pace of a serial link of baud bits per second, at 10 bits per
+    byte, so the pipeline runs at the slower of compute and the link, rather than their sum.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "planet_motion_regis.h"
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+#include "planet_motion_render.h"
+#include "planet_motion_ring.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                3653
+#define MODE                (RENDER_DELTA|RENDER_MACRO)
+
+#define DAY_SLOTS           64
+#define FRAME_SLOTS         64
+#define FRAME_BYTES_MAX     2048
+#define WRITE_BATCH         65536
+
+typedef struct day_record_s {       // the sky for a day, from the propagation thread
+    uint16_t day;
+    cartesian_coordinates_t sun;
+    cartesian_coordinates_t geo[SKY_BODIES_MAX];
+} day_record_t;
+
+typedef struct frame_record_s {     // a ReGIS frame, from the encoder thread
+    uint32_t bytes;
+    char data[FRAME_BYTES_MAX];
+} frame_record_t;
+
+static const planet_t * const bodies[] = { &moon, &mercury, &venus, &mars, &jupiter, &saturn };
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+static uint32_t baud;
+
+static ring_t dayRing;
+static ring_t frameRing;
+
+static double computeNs, encodeNs, writeNs;                         // busy time of each stage
+static uint8_t overflow;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+// write bytes, then wait until a link of baud would have carried everything written since due began
+static void linkWrite (int fd, const char * data, uint32_t bytes, double * due)
+{
+    struct timespec ts;
+    ssize_t n;
+
+    while (bytes) {
+        if ((n = write(fd, data, bytes)) <= 0)
+            return;
+        data += n;
+        bytes -= n;
+        if (baud) {
+            *due += (double)n * 10.0 * 1.0e9 / baud;
+            ts.tv_sec = (time_t)(*due / 1.0e9);
+            ts.tv_nsec = (long)fmod(*due, 1.0e9);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        }
+    }
+}
+
+// draw the sky of day into frame, from a sink rewound for each frame, or leave it empty and flag the
+// overflow when it is larger than a frame record, as part of a frame would break the ReGIS stream
+static void encode (render_t * render, regis_sink_t * sink, const sky_t * sky, uint16_t day, frame_record_t * frame)
+{
+    window_t window;
+    long bytes;
+
+    rewind(sink->fp);
+    window_new(&window, 768, 480, sink->fp);
+    renderSky(render, sky, day);
+    renderFrame(render, &window);
+    window_close(&window);
+    fflush(sink->fp);
+
+    bytes = ftell(sink->fp);
+    if (bytes > FRAME_BYTES_MAX) {
+        overflow = 1;
+        bytes = 0;
+    }
+    memcpy(frame->data, sink->buffer, bytes);
+    frame->bytes = (uint32_t)bytes;
+}
+
+static double sequential (int fd)
+{
+    static sky_t sky;
+    static render_t render;
+    static frame_record_t frame;
+    regis_sink_t sink;
+    double start, due;
+    uint16_t d;
+
+    if (!regisSinkOpen(&sink, NULL))
+        return 0.0;
+
+    skyInit(&sky, bodies, sizeof(bodies)/sizeof(bodies[0]), startDay, 1.0);
+    renderInit(&render, MODE);
+
+    due = start = now();
+    for (d = startDay; d != (uint16_t)(startDay + days); ++d) {
+        skyCoordinates(&sky, (FLOAT)d);
+        encode(&render, &sink, &sky, d, &frame);
+        if (overflow)
+            break;
+        linkWrite(fd, frame.data, frame.bytes, &due);               // a write per frame, as drawn
+    }
+
+    regisSinkClose(&sink);
+    return now() - start;
+}
+
+static void * computeThread (void * arg)
+{
+    static sky_t sky;
+    day_record_t * record;
+    double t;
+    uint16_t d;
+
+    (void)arg;
+    skyInit(&sky, bodies, sizeof(bodies)/sizeof(bodies[0]), startDay, 1.0);
+
+    for (d = startDay; d != (uint16_t)(startDay + days); ++d) {
+        record = ringProduce(&dayRing);
+        t = now();
+        skyCoordinates(&sky, (FLOAT)d);
+        record->day = d;
+        record->sun = sky.sun;
+        memcpy(record->geo, sky.geo, sky.bodies * sizeof(cartesian_coordinates_t));
+        computeNs += now() - t;
+        ringPublish(&dayRing);
+    }
+    ringClose(&dayRing);
+    return NULL;
+}
+
+static void * encodeThread (void * arg)
+{
+    static sky_t sky;
+    static render_t render;
+    regis_sink_t sink;
+    day_record_t * record;
+    frame_record_t * frame;
+    double t;
+
+    (void)arg;
+    skyInit(&sky, bodies, sizeof(bodies)/sizeof(bodies[0]), startDay, 1.0);    // the bodies, for renderSky()
+    renderInit(&render, MODE);
+    if (!regisSinkOpen(&sink, NULL))
+        overflow = 1;
+
+    while ((record = ringConsume(&dayRing)) != NULL) {
+        frame = ringProduce(&frameRing);
+        t = now();
+        sky.sun = record->sun;
+        memcpy(sky.geo, record->geo, sky.bodies * sizeof(cartesian_coordinates_t));
+        if (sink.fp)
+            encode(&render, &sink, &sky, record->day, frame);
+        else
+            frame->bytes = 0;
+        encodeNs += now() - t;
+        ringRelease(&dayRing);
+        ringPublish(&frameRing);
+    }
+    ringClose(&frameRing);
+    regisSinkClose(&sink);
+    return NULL;
+}
+
+// the time to run the pipeline, or 0 when it could not be started
+static double pipelined (int fd, uint32_t * bytes, uint32_t * writes)
+{
+    static char batch[WRITE_BATCH];
+    pthread_t compute, encoder;
+    frame_record_t * frame;
+    uint32_t n = 0;
+    double start, due, t;
+
+    *bytes = *writes = 0;
+    computeNs = encodeNs = writeNs = 0.0;
+
+    if (!ringInit(&dayRing, DAY_SLOTS, sizeof(day_record_t)) || !ringInit(&frameRing, FRAME_SLOTS, sizeof(frame_record_t)))
+        return 0.0;
+
+    due = start = now();
+    if (pthread_create(&compute, NULL, computeThread, NULL) != 0)
+        return 0.0;
+    if (pthread_create(&encoder, NULL, encodeThread, NULL) != 0) {
+        while (ringConsume(&dayRing) != NULL)                       // let the compute thread finish
+            ringRelease(&dayRing);
+        pthread_join(compute, NULL);
+        return 0.0;
+    }
+
+    while ((frame = ringConsume(&frameRing)) != NULL) {
+        if (overflow) {                                             // the frames after a dropped one are deltas of it
+            ringRelease(&frameRing);
+            continue;
+        }
+        if (n + frame->bytes > WRITE_BATCH) {                       // write a full batch
+            t = now();
+            linkWrite(fd, batch, n, &due);
+            writeNs += now() - t;
+            ++*writes;
+            n = 0;
+        }
+        memcpy(&batch[n], frame->data, frame->bytes);
+        n += frame->bytes;
+        *bytes += frame->bytes;
+        ringRelease(&frameRing);
+    }
+    if (n) {
+        t = now();
+        linkWrite(fd, batch, n, &due);
+        writeNs += now() - t;
+        ++*writes;
+    }
+
+    pthread_join(compute, NULL);
+    pthread_join(encoder, NULL);
+    return now() - start;
+}
+
+int main (int argc, char ** argv)
+{
+    const char * file = "/dev/null";
+    uint32_t bytes, writes;
+    double ns;
+    int fd, null, k;
+
+    for (k = 1; k < argc && argv[k][0] == '-' && argv[k][1] != '\0'; ++k) {
+        if (strcmp(argv[k], "-b") == 0 && k + 1 < argc) {
+            baud = (uint32_t)atol(argv[++k]);
+        } else if (strcmp(argv[k], "-o") == 0 && k + 1 < argc) {
+            file = argv[++k];
+        } else {
+            break;
+        }
+    }
+    if (k < argc) startDay = (uint16_t)atoi(argv[k++]);
+    if (k < argc) days = (uint16_t)atoi(argv[k++]);
+    if (k < argc || days == 0) {
+        fprintf(stderr, "usage: %s [-b baud] [-o file] [start_day] [days]\n", argv[0]);
+        return 1;
+    }
+
+    fd = strcmp(file, "-") == 0 ? STDOUT_FILENO : open(file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(file);
+        return 1;
+    }
+    if ((null = open("/dev/null", O_WRONLY)) < 0) {                 // the sequential baseline's output
+        perror("/dev/null");
+        return 1;
+    }
+
+    fprintf(stderr, "%u frames from day %u, %s%s%u baud\n", days, startDay, file, baud ? ", " : ", unlimited ", baud);
+
+    ns = sequential(null);
+    close(null);
+    if (overflow) {
+        fprintf(stderr, "a frame was larger than %u bytes\n", FRAME_BYTES_MAX);
+        if (fd != STDOUT_FILENO)
+            close(fd);
+        return 1;
+    }
+    fprintf(stderr, "%-12s %10.3f s %10.1f frames/sec, a write per frame\n", "sequential", ns / 1.0e9, days * 1.0e9 / ns);
+
+    if ((ns = pipelined(fd, &bytes, &writes)) == 0.0) {
+        fprintf(stderr, "can't start the pipeline\n");
+        ringFree(&dayRing);
+        ringFree(&frameRing);
+        if (fd != STDOUT_FILENO)
+            close(fd);
+        return 1;
+    }
+    fprintf(stderr, "%-12s %10.3f s %10.1f frames/sec, %u writes of %.0f bytes\n", "pipelined", ns / 1.0e9, days * 1.0e9 / ns, writes, writes ? (double)bytes / writes : 0.0);
+    fprintf(stderr, "%-12s %10.3f s compute %8.3f s encode %8.3f s write\n", "busy", computeNs / 1.0e9, encodeNs / 1.0e9, writeNs / 1.0e9);
+    fprintf(stderr, "%-12s %10u compute %8u encode %8u write\n", "waits", dayRing.stalls, frameRing.stalls + dayRing.starves, frameRing.starves);
+
+    ringFree(&dayRing);
+    ringFree(&frameRing);
+    if (fd != STDOUT_FILENO)
+        close(fd);
+
+    if (overflow) {
+        fprintf(stderr, "a frame was larger than %u bytes, nothing from it on was sent\n", FRAME_BYTES_MAX);
+        return 1;
+    }
+    return 0;
+}
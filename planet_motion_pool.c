@@ -0,0 +1,171 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "planet_motion_pool.h"
+
+// Tasks are dealt to the workers in turn, so each worker holds every workers'th task in order.
+// A worker runs the first task of its own deque, and when that is empty, or outside the window,
+// steals the first task of another worker's deque. Thieves take the front, rather than the back as
+// is usual, because the window would block a task taken from the back, and the front is what the
+// ordered output waits on.
+
+typedef struct pool_worker_s {
+    pool_t * pool;
+    uint16_t worker;
+} pool_worker_t;
+
+// take the first task of deque d that is within limit, as UINT32_MAX when there is none, or
+// UINT32_MAX-1 when the deque is not empty but its first task is outside the window
+static uint32_t poolTake (pool_deque_t * deque, uint32_t limit)
+{
+    uint32_t task = UINT32_MAX;
+
+    pthread_mutex_lock(&deque->lock);
+    if (deque->front < deque->back) {
+        task = deque->task[deque->front];
+        if (task < limit)
+            ++deque->front;
+        else
+            task = UINT32_MAX-1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return task;
+}
+
+static void * poolWorker (void * arg)
+{
+    pool_worker_t * self = arg;
+    pool_t * pool = self->pool;
+    uint16_t w = self->worker;
+    uint32_t task, limit;
+    uint16_t k;
+    uint8_t blocked;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        limit = pool->emitted + pool->window;
+        pthread_mutex_unlock(&pool->lock);
+
+        task = poolTake(&pool->deque[w], limit);
+        blocked = (task == UINT32_MAX-1);
+
+        for (k = 1; task >= UINT32_MAX-1 && k < pool->workers; ++k) {
+            task = poolTake(&pool->deque[(w + k) % pool->workers], limit);
+            if (task == UINT32_MAX-1)
+                blocked = 1;
+            else if (task < UINT32_MAX-1)
+                ++pool->deque[w].steals;
+        }
+
+        if (task >= UINT32_MAX-1) {
+            if (!blocked)
+                return NULL;                                        // every deque is empty
+
+            pthread_mutex_lock(&pool->lock);                        // wait for the window to move
+            while (pool->emitted + pool->window == limit)
+                pthread_cond_wait(&pool->space, &pool->lock);
+            pthread_mutex_unlock(&pool->lock);
+            continue;
+        }
+
+        pool->run(pool->context, task, task % pool->window, w);
+        ++pool->deque[w].runs;
+
+        pthread_mutex_lock(&pool->lock);
+        pool->done[task % pool->window] = task + 1;
+        pthread_cond_signal(&pool->ready);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+uint8_t poolRun ( pool_t * pool, uint16_t workers, uint32_t tasks, uint32_t window, pool_run_t run, pool_emit_t emit, void * context )
+{
+    pool_worker_t self[POOL_WORKERS_MAX];
+    uint32_t task, slot;
+    uint16_t w, started;
+    uint8_t status = 1;
+
+    if (workers == 0 || workers > POOL_WORKERS_MAX || window == 0)
+        return 0;
+
+    pool->workers = workers;
+    pool->tasks = tasks;
+    pool->window = window;
+    pool->emitted = 0;
+    pool->run = run;
+    pool->emit = emit;
+    pool->context = context;
+
+    pool->done = calloc(window, sizeof(uint32_t));
+    if (pool->done == NULL)
+        return 0;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->ready, NULL);
+    pthread_cond_init(&pool->space, NULL);
+
+    for (w = 0; w < workers; ++w) {
+        pool_deque_t * deque = &pool->deque[w];
+
+        pthread_mutex_init(&deque->lock, NULL);
+        deque->task = malloc((tasks / workers + 1) * sizeof(uint32_t));
+        deque->front = deque->back = 0;
+        deque->runs = deque->steals = 0;
+        if (deque->task == NULL)
+            status = 0;
+        for (task = w; deque->task && task < tasks; task += workers)
+            deque->task[deque->back++] = task;
+    }
+
+    for (started = 0; status && started < workers; ) {               // count only the threads created
+        self[started].pool = pool;
+        self[started].worker = started;
+        if (pthread_create(&pool->thread[started], NULL, poolWorker, &self[started]) != 0)
+            status = 0;
+        else
+            ++started;
+    }
+
+    if (status) {
+        for (task = 0; task < tasks; ++task) {
+            slot = task % window;
+
+            pthread_mutex_lock(&pool->lock);
+            while (pool->done[slot] != task + 1)
+                pthread_cond_wait(&pool->ready, &pool->lock);
+            pthread_mutex_unlock(&pool->lock);
+
+            emit(context, task, slot);
+
+            pthread_mutex_lock(&pool->lock);
+            pool->emitted = task + 1;
+            pthread_cond_broadcast(&pool->space);
+            pthread_mutex_unlock(&pool->lock);
+        }
+    } else {
+        for (w = 0; w < workers; ++w) {                             // let the started workers finish
+            pthread_mutex_lock(&pool->deque[w].lock);
+            pool->deque[w].front = pool->deque[w].back;
+            pthread_mutex_unlock(&pool->deque[w].lock);
+        }
+        pthread_mutex_lock(&pool->lock);
+        pool->emitted = tasks;
+        pthread_cond_broadcast(&pool->space);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    for (w = 0; w < started; ++w)
+        pthread_join(pool->thread[w], NULL);
+
+    for (w = 0; w < workers; ++w) {
+        free(pool->deque[w].task);
+        pthread_mutex_destroy(&pool->deque[w].lock);
+    }
+    pthread_cond_destroy(&pool->space);
+    pthread_cond_destroy(&pool->ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->done);
+    return status;
+}
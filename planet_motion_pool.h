@@ -0,0 +1,83 @@
+/*
+ * planet_motion_pool.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_POOL_H
+#define _PLANET_MOTION_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host (gcc, clang, POSIX threads) work stealing pool, running tasks 0 to tasks-1 on its workers,
+// with the results handed back in task order through a window of result slots.
+// Needs <pthread.h> first.
+
+#define POOL_WORKERS_MAX    256
+
+// type definitions
+
+typedef void (*pool_run_t) ( void * context, uint32_t task, uint32_t slot, uint16_t worker );
+typedef void (*pool_emit_t) ( void * context, uint32_t task, uint32_t slot );
+
+typedef struct pool_deque_s {       // the tasks dealt to a worker
+    pthread_mutex_t lock;
+    uint32_t * task;
+    uint32_t front, back;   // tasks [front, back) are left.
+    uint32_t runs;          // tasks this worker ran.
+    uint32_t steals;        // of which were taken from another worker.
+} pool_deque_t;
+
+typedef struct pool_s {
+    uint16_t workers;
+    pthread_t thread[POOL_WORKERS_MAX];
+    pool_deque_t deque[POOL_WORKERS_MAX];
+    pthread_mutex_t lock;   // guards emitted and done, with the conditions.
+    pthread_cond_t ready;   // a task is done.
+    pthread_cond_t space;   // a slot is free.
+    uint32_t tasks;
+    uint32_t window;        // result slots, task t using slot t % window.
+    uint32_t emitted;       // tasks handed back, in order.
+    uint32_t * done;        // task + 1 of the task done in each slot.
+    pool_run_t run;
+    pool_emit_t emit;
+    void * context;
+} pool_t;
+
+// pool functions (C)
+
+// Run tasks on workers threads, calling run(context, task, slot, worker) on a worker for each task,
+// and emit(context, task, slot) on the calling thread for each task in order, after which the slot
+// is reused. No task runs more than window tasks ahead of the last emitted, bounding the memory held.
+// Returns 0 if the threads or memory could not be had.
+uint8_t poolRun ( pool_t * pool, uint16_t workers, uint32_t tasks, uint32_t window, pool_run_t run, pool_emit_t emit, void * context );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_POOL_H  */
@@ -0,0 +1,200 @@
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_profile.h"
+
+// Only counters are touched per call, so a hook costs an increment. The clock is read just at
+// the edges of each stage, as timing every Kepler solution or sine would cost more than the call.
+
+uint8_t profileBody;
+uint32_t profileCount[PLANETS + 1][PROFILE_COUNTERS];
+uint32_t profileRegis;
+
+static const char * const stageNames[PROFILE_STAGES] = { "sky", "render", "draw", "output" };
+static const char * const counterNames[PROFILE_COUNTERS] = { "positions", "kepler", "newton", "rev", "trig" };
+
+static FILE * csv;
+
+static uint64_t started[PROFILE_STAGES];                            // clock at profileStart()
+static uint64_t frameTime[PROFILE_STAGES];                          // ns in each stage of this frame
+static uint64_t totalTime[PROFILE_STAGES];
+static uint64_t maxTime[PROFILE_STAGES];
+
+static uint32_t frameCount[PROFILE_COUNTERS];                       // totals of every body at the start of this frame
+static uint32_t frameRegis;
+static uint32_t frames;
+
+static uint32_t histogram[PROFILE_BUCKETS];                         // frames by log2 of their total ns
+
+static uint64_t now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t counterTotal (uint8_t counter)
+{
+    uint32_t total = 0;
+    uint8_t k;
+
+    for (k = 0; k <= PLANETS; ++k)
+        total += profileCount[k][counter];
+    return total;
+}
+
+uint8_t profileIndex (const planet_t * planet)
+{
+    uint8_t k;
+
+    if (planet == NULL)
+        return 0;                                                   // planets[0] is the Sun
+    for (k = 0; k < PLANETS; ++k) {
+        if (planets[k] == planet)
+            return k;
+    }
+    return PLANETS;
+}
+
+void profileInit ( void )
+{
+    const char * file = getenv("PLANET_MOTION_PROFILE");
+    uint8_t k;
+
+    memset(profileCount, 0, sizeof(profileCount));
+    memset(frameTime, 0, sizeof(frameTime));
+    memset(totalTime, 0, sizeof(totalTime));
+    memset(maxTime, 0, sizeof(maxTime));
+    memset(frameCount, 0, sizeof(frameCount));
+    memset(histogram, 0, sizeof(histogram));
+    profileRegis = frameRegis = frames = 0;
+
+    csv = NULL;
+    if (file != NULL && *file != '\0' && (csv = fopen(file, "w")) == NULL)
+        fprintf(stderr, "profile: can't write %s\n", file);
+
+    if (csv) {
+        fputs("frame,day", csv);
+        for (k = 0; k < PROFILE_STAGES; ++k)
+            fprintf(csv, ",%s_ns", stageNames[k]);
+        for (k = 0; k < PROFILE_COUNTERS; ++k)
+            fprintf(csv, ",%s", counterNames[k]);
+        fputs(",regis\n", csv);
+    }
+}
+
+void profileStart ( uint8_t stage )
+{
+    started[stage] = now();
+}
+
+void profileStop ( uint8_t stage )
+{
+    frameTime[stage] += now() - started[stage];
+}
+
+void profileFrame ( FLOAT day )
+{
+    uint64_t total = 0;
+    uint8_t k, bucket;
+
+    if (csv)
+        fprintf(csv, "%u,%.1f", frames, (double)day);
+
+    for (k = 0; k < PROFILE_STAGES; ++k) {
+        if (csv)
+            fprintf(csv, ",%llu", (unsigned long long)frameTime[k]);
+        totalTime[k] += frameTime[k];
+        if (frameTime[k] > maxTime[k])
+            maxTime[k] = frameTime[k];
+        total += frameTime[k];
+        frameTime[k] = 0;
+    }
+
+    for (k = 0; k < PROFILE_COUNTERS; ++k) {
+        uint32_t count = counterTotal(k);
+
+        if (csv)
+            fprintf(csv, ",%u", count - frameCount[k]);
+        frameCount[k] = count;
+    }
+
+    if (csv)
+        fprintf(csv, ",%u\n", profileRegis - frameRegis);
+    frameRegis = profileRegis;
+
+    for (bucket = 0; bucket < PROFILE_BUCKETS - 1 && (total >> (bucket + 1)) != 0; ++bucket)
+        ;
+    ++histogram[bucket];
+    ++frames;
+}
+
+void profileSummary ( FILE * fp )
+{
+    uint64_t total = 0, peak = 0;
+    uint8_t k, c;
+
+    if (csv) {
+        fclose(csv);
+        csv = NULL;
+    }
+
+    if (frames == 0) {
+        fputs("profile: no frames\n", fp);
+        return;
+    }
+
+    fprintf(fp, "%u frames\n\n", frames);
+
+    fprintf(fp, "%-10s", "body");
+    for (c = 0; c < PROFILE_COUNTERS; ++c)
+        fprintf(fp, " %10s", counterNames[c]);
+    fputs("  (per frame)\n", fp);
+
+    for (k = 0; k <= PLANETS; ++k) {
+        if (profileCount[k][PROFILE_POSITIONS] == 0 && profileCount[k][PROFILE_KEPLER] == 0)
+            continue;
+        fprintf(fp, "%-10s", k < PLANETS ? planets[k]->name : "other");
+        for (c = 0; c < PROFILE_COUNTERS; ++c)
+            fprintf(fp, " %10.2f", (double)profileCount[k][c] / frames);
+        fputc('\n', fp);
+    }
+    fprintf(fp, "%-10s", "total");
+    for (c = 0; c < PROFILE_COUNTERS; ++c)
+        fprintf(fp, " %10.2f", (double)counterTotal(c) / frames);
+    fprintf(fp, "\n%-10s %10.2f\n\n", "regis", (double)profileRegis / frames);
+
+    for (k = 0; k < PROFILE_STAGES; ++k)
+        total += totalTime[k];
+
+    fprintf(fp, "%-10s %12s %10s %10s %7s\n", "stage", "total ms", "mean us", "max us", "share");
+    for (k = 0; k < PROFILE_STAGES; ++k)
+        fprintf(fp, "%-10s %12.3f %10.3f %10.3f %6.1f%%\n", stageNames[k], totalTime[k] * 1.0e-6,
+                totalTime[k] * 1.0e-3 / frames, maxTime[k] * 1.0e-3, total ? 100.0 * totalTime[k] / total : 0.0);
+    fprintf(fp, "%-10s %12.3f %10.3f\n\n", "frame", total * 1.0e-6, total * 1.0e-3 / frames);
+
+    for (k = 0; k < PROFILE_BUCKETS; ++k) {
+        if (histogram[k] > peak)
+            peak = histogram[k];
+    }
+
+    fputs("frame time histogram, frames from each time\n", fp);
+    for (k = 0; k < PROFILE_BUCKETS; ++k) {
+        uint32_t bar;
+
+        if (histogram[k] == 0)
+            continue;
+        fprintf(fp, "%10.3f us %6u ", ldexp(1.0, k) * 1.0e-3, histogram[k]);
+        for (bar = (uint32_t)((histogram[k] * 50 + peak - 1) / peak); bar; --bar)
+            fputc('#', fp);
+        fputc('\n', fp);
+    }
+}
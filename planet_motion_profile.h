@@ -0,0 +1,94 @@
+/*
+ * planet_motion_profile.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_PROFILE_H
+#define _PLANET_MOTION_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host instrumentation of the main loop, built with make PROFILE=1 (PLANET_MOTION_PROFILE).
+// The counters of each body are kept by the hooks in planet_motion.h, and the stages of a frame
+// are timed here in ns. Each frame can be written as a CSV line to the file named by the
+// PLANET_MOTION_PROFILE environment variable, and the totals are summarised at the end.
+// Without PLANET_MOTION_PROFILE every macro here, and in planet_motion.h, is empty.
+
+// stages of a frame
+
+#define PROFILE_SKY         0       // skyCoordinates(), the Sun and every body for the day
+#define PROFILE_RENDER      1       // renderSky(), the draw list for the day
+#define PROFILE_DRAW        2       // renderFrame(), the ReGIS commands for what changed
+#define PROFILE_OUTPUT      3       // window_new() and window_close(), opening and flushing the frame
+
+#define PROFILE_STAGES      4
+
+// power of 2 buckets of the frame time histogram, from 1 ns
+
+#define PROFILE_BUCKETS     32
+
+#ifdef PLANET_MOTION_PROFILE
+    #define PROFILE_INIT()      profileInit()
+    #define PROFILE_START(s)    profileStart(s)
+    #define PROFILE_STOP(s)     profileStop(s)
+    #define PROFILE_FRAME(day)  profileFrame(day)
+    #define PROFILE_SUMMARY()   profileSummary(stderr)
+    #define PROFILE_REGIS()     (++profileRegis)
+#else
+    #define PROFILE_INIT()
+    #define PROFILE_START(s)
+    #define PROFILE_STOP(s)
+    #define PROFILE_FRAME(day)
+    #define PROFILE_SUMMARY()
+    #define PROFILE_REGIS()
+#endif
+
+// draw_* and window_* calls, counted by planet_motion_regis.c
+
+extern uint32_t profileRegis;
+
+// profile functions (C)
+
+// Clear the counters and timers, and open the CSV file named by PLANET_MOTION_PROFILE, if set.
+void profileInit ( void );
+
+// Time a stage, accumulating into the current frame.
+void profileStart ( uint8_t stage );
+void profileStop ( uint8_t stage );
+
+// End the frame for day, writing its CSV line and adding it to the totals.
+void profileFrame ( FLOAT day );
+
+// Write the counters of each body, the stage times and the frame time histogram to fp, and close the CSV file.
+void profileSummary ( FILE * fp );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_PROFILE_H  */
@@ -0,0 +1,136 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_regis.h"
+#include "planet_motion_profile.h"
+
+// the ReGIS intensity letters, in w_intensity_t order
+static const char intensities[] = "DBRMGCYW";
+
+unsigned char window_new ( window_t * win, uint16_t width, uint16_t height, FILE * fp )
+{
+    PROFILE_REGIS();
+    win->width = width;
+    win->height = height;
+    win->fp = fp;
+
+    fputs("\033P1p", fp);                                           // enter ReGIS
+    return 1;
+}
+
+void window_clear ( window_t * win )
+{
+    PROFILE_REGIS();
+    fputs("S(E)", win->fp);
+}
+
+void window_close ( window_t * win )
+{
+    PROFILE_REGIS();
+    fputs("\033\\\r\n", win->fp);                                   // leave ReGIS
+}
+
+void draw_intensity ( window_t * win, w_intensity_t intensity )
+{
+    PROFILE_REGIS();
+    fprintf(win->fp, "W(I(%c))", intensities[intensity & 0x07]);
+}
+
+void draw_abs ( window_t * win, uint16_t x, uint16_t y )
+{
+    PROFILE_REGIS();
+    fprintf(win->fp, "P[%03u,%03u]", x, y);
+}
+
+void draw_circle ( window_t * win, uint16_t radius )
+{
+    PROFILE_REGIS();
+    fprintf(win->fp, "C[+%03u]", radius);
+}
+
+void draw_circle_fill ( window_t * win, uint16_t radius )
+{
+    PROFILE_REGIS();
+    fprintf(win->fp, "C(W(S1))[+%03u]", radius);
+}
+
+void draw_text ( window_t * win, char * text, uint8_t size )
+{
+    PROFILE_REGIS();
+    fprintf(win->fp, "T(S%02u)\"%s\"", size, text);
+}
+
+uint8_t regisSinkOpen ( regis_sink_t * sink, const char * file )
+{
+    sink->buffer = NULL;
+    sink->size = 0;
+    sink->fileBuffer = NULL;
+
+    if (file == NULL) {
+        sink->fp = open_memstream(&sink->buffer, &sink->size);
+        return sink->fp != NULL;
+    }
+
+    if ((sink->fp = fopen(file, "wb")) == NULL)
+        return 0;
+    if ((sink->fileBuffer = malloc(REGIS_SINK_BUFFER)) != NULL)
+        setvbuf(sink->fp, sink->fileBuffer, _IOFBF, REGIS_SINK_BUFFER);
+    return 1;
+}
+
+void regisSinkClose ( regis_sink_t * sink )
+{
+    if (sink->fp)
+        fclose(sink->fp);
+    free(sink->buffer);
+    free(sink->fileBuffer);
+    sink->fp = NULL;
+    sink->buffer = NULL;
+    sink->fileBuffer = NULL;
+    sink->size = 0;
+}
+
+uint16_t regisCommands ( const char * s, size_t n )
+{
+    uint16_t commands = 0;
+    uint8_t depth = 0;                  // of options (), and coordinates []
+    char quote = 0;
+    size_t k;
+
+    for (k = 0; k < n; ++k) {
+        char c = s[k];
+
+        if (quote) {
+            if (c == quote)
+                quote = 0;
+        } else if (c == '\033') {                                   // skip the escape sequence
+            if (k + 1 < n && s[k+1] == 'P') {
+                for (k += 2; k < n && !isalpha((unsigned char)s[k]); ++k)
+                    ;                                               // DCS parameters, and the final p
+            } else {
+                ++k;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '(' || c == '[') {
+            ++depth;
+        } else if ((c == ')' || c == ']') && depth) {
+            --depth;
+        } else if (depth == 0 && c == '@') {
+            if (k + 1 < n && s[k+1] == ';') {
+                ++k;                                                // end of a definition
+            } else {
+                ++commands;                                         // definition @:X or invocation @X
+                k += (k + 1 < n && s[k+1] == ':') ? 2 : 1;
+            }
+        } else if (depth == 0 && isalpha((unsigned char)c)) {
+            ++commands;
+        }
+    }
+    return commands;
+}
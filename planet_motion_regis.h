@@ -0,0 +1,89 @@
+/*
+ * planet_motion_regis.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_REGIS_H
+#define _PLANET_MOTION_REGIS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host (gcc, clang) stand in for the z88dk ReGIS library, for the calls used here.
+// Each command is written to the window's stream as it is drawn, in the same bytes,
+// which can be a file or a memory sink, so frames can be captured and measured headless.
+
+// size of a file sink's buffer
+
+#define REGIS_SINK_BUFFER   65536
+
+// type definitions
+
+typedef enum {
+    _D, _B, _R, _M, _G, _C, _Y, _W  // dark, blue, red, magenta, green, cyan, yellow, white
+} w_intensity_t;
+
+typedef struct window_s {
+    uint16_t width;
+    uint16_t height;
+    FILE * fp;
+} window_t;
+
+typedef struct regis_sink_s {       // a buffered file, or memory, to draw into
+    FILE * fp;              // the stream to give window_new().
+    char * buffer;          // the bytes written to a memory sink, valid after fflush(fp).
+    size_t size;            // the bytes written to a memory sink, valid after fflush(fp).
+    char * fileBuffer;      // the stdio buffer of a file sink.
+} regis_sink_t;
+
+// ReGIS functions (C)
+
+unsigned char window_new ( window_t * win, uint16_t width, uint16_t height, FILE * fp );
+void window_clear ( window_t * win );
+void window_close ( window_t * win );
+
+void draw_intensity ( window_t * win, w_intensity_t intensity );
+void draw_abs ( window_t * win, uint16_t x, uint16_t y );
+void draw_circle ( window_t * win, uint16_t radius );
+void draw_circle_fill ( window_t * win, uint16_t radius );
+void draw_text ( window_t * win, char * text, uint8_t size );
+
+// sink functions (C)
+
+// Open a sink writing to file, or to memory when file is NULL, returning 0 on failure.
+uint8_t regisSinkOpen ( regis_sink_t * sink, const char * file );
+void regisSinkClose ( regis_sink_t * sink );
+
+// The ReGIS commands in the n bytes of s: each command letter outside options, coordinates and quoted
+// text, and each macrograph definition and invocation, with escape sequences ignored.
+uint16_t regisCommands ( const char * s, size_t n );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_REGIS_H  */
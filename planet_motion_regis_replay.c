@@ -0,0 +1,226 @@
+/*
+ * planet_motion_regis_replay.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host capture and replay of the ReGIS frames of the animation, over a simulated serial link.
+
+    build and run with:
+
+    make
+    ./planet_motion_regis_replay [-b baud] [-p] [capture]
+    ./planet_motion_regis_replay -c capture [start_day] [days] [mode]
+
+    A capture, by default doc/planet_motion.capture, is split into frames at each ReGIS entry
+    (ESC P 1 p), and the bytes and commands of each frame are counted. The frames per second are
+    those of a serial link of baud bits per second, at 10 bits per byte. With -p the capture is
+    written to stdout at the pace of the link, to watch on a terminal, and the report goes to stderr.
+
+    With -c the animation is drawn headless into the capture file, with the render mode bits
+    (0 full, 1 delta, 3 delta and macrographs), to be replayed.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion_regis.h"
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+#include "planet_motion_render.h"
+
+#define CAPTURE             "doc/planet_motion.capture"
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+#define MODE                (RENDER_DELTA|RENDER_MACRO)
+#define BAUD                9600
+
+static const planet_t * const bodies[] = { &moon, &mercury, &venus, &mars, &jupiter, &saturn };
+
+static sky_t sky;
+static render_t render;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static void usage (const char * name)
+{
+    fprintf(stderr, "usage: %s [-b baud] [-p] [capture]\n", name);
+    fprintf(stderr, "       %s -c capture [start_day] [days] [mode]\n", name);
+}
+
+static int capture (const char * file, uint16_t startDay, uint16_t days, uint8_t mode)
+{
+    regis_sink_t sink;
+    window_t window;
+    uint16_t d;
+
+    if (!regisSinkOpen(&sink, file)) {
+        perror(file);
+        return 1;
+    }
+
+    skyInit(&sky, bodies, sizeof(bodies)/sizeof(bodies[0]), startDay, 1.0);
+    renderInit(&render, mode);
+
+    for (d = startDay; d < startDay + days; ++d) {
+        window_new(&window, 768, 480, sink.fp);
+        skyCoordinates(&sky, (FLOAT)d);
+        renderSky(&render, &sky, d);
+        renderFrame(&render, &window);
+        window_close(&window);
+    }
+
+    printf("%s: %u frames, %ld bytes\n", file, days, ftell(sink.fp));
+    regisSinkClose(&sink);
+    return 0;
+}
+
+// the offset of the frame after the one starting at s[k], or n
+static size_t nextFrame (const char * s, size_t n, size_t k)
+{
+    for (++k; k + 4 <= n; ++k) {
+        if (memcmp(&s[k], "\033P1p", 4) == 0)
+            return k;
+    }
+    return n;
+}
+
+static int replay (const char * file, uint32_t baud, uint8_t pace)
+{
+    FILE * out = pace ? stderr : stdout;
+    FILE * fp;
+    char * s;
+    long n;
+    size_t k, next;
+    uint32_t frames = 0, commands = 0;
+    uint32_t bytesMin = 0xffffffff, bytesMax = 0;
+    uint16_t commandsMax = 0, c;
+    double start, link;
+
+    if ((fp = fopen(file, "rb")) == NULL) {
+        perror(file);
+        return 1;
+    }
+    fseek(fp, 0, SEEK_END);
+    n = ftell(fp);
+    rewind(fp);
+    if (n <= 0 || (s = malloc(n)) == NULL || fread(s, 1, n, fp) != (size_t)n) {
+        fprintf(stderr, "%s: cannot read\n", file);
+        fclose(fp);
+        return 1;
+    }
+    fclose(fp);
+
+    start = now();
+    for (k = 0; k < (size_t)n; k = next) {
+        next = nextFrame(s, n, k);
+        c = regisCommands(&s[k], next - k);
+
+        ++frames;
+        commands += c;
+        if (c > commandsMax)
+            commandsMax = c;
+        if (next - k < bytesMin)
+            bytesMin = next - k;
+        if (next - k > bytesMax)
+            bytesMax = next - k;
+
+        if (pace) {                                                 // wait for the link to carry the frame
+            struct timespec ts;
+
+            fwrite(&s[k], 1, next - k, stdout);
+            fflush(stdout);
+            link = (double)next * 10.0 * 1.0e9 / baud - (now() - start);
+            if (link > 0.0) {
+                ts.tv_sec = (time_t)(link / 1.0e9);
+                ts.tv_nsec = (long)fmod(link, 1.0e9);
+                nanosleep(&ts, NULL);
+            }
+        }
+    }
+    free(s);
+
+    link = (double)n * 10.0 / baud;                                 // seconds
+    fprintf(out, "%-24s %s\n", "capture", file);
+    fprintf(out, "%-24s %10u\n", "baud", baud);
+    fprintf(out, "%-24s %10u\n", "frames", frames);
+    fprintf(out, "%-24s %10ld\n", "bytes", n);
+    fprintf(out, "%-24s %10.1f %10u %10u\n", "bytes/frame, min, max", (double)n / frames, bytesMin, bytesMax);
+    fprintf(out, "%-24s %10.1f %10s %10u\n", "commands/frame, max", (double)commands / frames, "", commandsMax);
+    fprintf(out, "%-24s %10.1f\n", "link seconds", link);
+    fprintf(out, "%-24s %10.2f %10s %10.2f\n", "frames/sec, slowest", frames / link, "", baud / 10.0 / bytesMax);
+    if (pace)
+        fprintf(out, "%-24s %10.1f\n", "replay seconds", (now() - start) / 1.0e9);
+    return 0;
+}
+
+int main (int argc, char ** argv)
+{
+    const char * file = CAPTURE;
+    uint32_t baud = BAUD;
+    uint8_t pace = 0;
+    int k = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-c") == 0) {
+        uint16_t startDay = argc > 3 ? (uint16_t)atoi(argv[3]) : START_DAY;
+        uint16_t days = argc > 4 ? (uint16_t)atoi(argv[4]) : DAYS;
+        uint8_t mode = argc > 5 ? (uint8_t)atoi(argv[5]) : MODE;
+
+        if (argc > 6 || days == 0) {
+            usage(argv[0]);
+            return 1;
+        }
+        return capture(argv[2], startDay, days, mode);
+    }
+
+    for (; k < argc && argv[k][0] == '-'; ++k) {
+        if (strcmp(argv[k], "-b") == 0 && k + 1 < argc) {
+            baud = (uint32_t)atol(argv[++k]);
+        } else if (strcmp(argv[k], "-p") == 0) {
+            pace = 1;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (k < argc)
+        file = argv[k++];
+    if (k < argc || baud == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    return replay(file, baud, pace);
+}
@@ -0,0 +1,412 @@
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#if __8085
+#include <_DEVELOPMENT/sccz80/lib/cpm/regis.h>
+#elif __RC2014
+#include <lib/rc2014/regis.h>
+#elif __YAZ180
+#include <lib/yaz180/regis.h>
+#elif __CPM
+#include <lib/cpm/regis.h>
+#else
+#include "planet_motion_regis.h"
+#endif
+
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+#include "planet_motion_render.h"
+
+// Most of a frame is the same as the last one. The Earth, and the orbits of bodies that moved by
+// less than a pixel, need not be sent again, so long as nothing drawn over or erased touches them.
+// The byte counts follow the command formats of the ReGIS library, so no output need be captured.
+//
+// Drawn in full, the glyphs and orbits are the same commands every day, apart from where they are drawn.
+// As macrographs they are sent once, and after that each costs a pen move and two bytes.
+
+#define RENDER_CELL_X   9                   // text cell at size 1, in pixels
+#define RENDER_CELL_Y   20
+
+typedef struct render_glyph_s {     // how a body is drawn
+    const planet_t * planet;
+    uint8_t intensity;
+    uint8_t radius;         // radius of the body's disc.
+    uint8_t rings;          // rings drawn around the disc, 2 pixels apart.
+    uint16_t scale;         // pixels per AU of its orbit.
+} render_glyph_t;
+
+static const render_glyph_t glyphs[] = {
+    { &moon,    _W,  3, 0, 100*RENDER_SCALE_AU },
+    { &mercury, _R,  4, 0, RENDER_SCALE_AU },
+    { &venus,   _C,  8, 0, RENDER_SCALE_AU },
+    { &mars,    _R,  6, 0, RENDER_SCALE_AU },
+    { &jupiter, _C, 16, 0, RENDER_SCALE_AU },
+    { &saturn,  _W, 12, 3, RENDER_SCALE_AU },
+    { &uranus,  _G,  8, 0, RENDER_SCALE_AU },
+    { &neptune, _B,  8, 0, RENDER_SCALE_AU }
+};
+
+static const render_glyph_t glyphOther = { NULL, _W, 4, 0, RENDER_SCALE_AU };
+
+// decimal digits of n, with at least width digits
+static uint8_t digits (uint16_t n, uint8_t width)
+{
+    uint8_t k = 1;
+
+    while (n >= 10) {
+        n /= 10;
+        ++k;
+    }
+    return k > width ? k : width;
+}
+
+// draw an item in intensity, moving the pen and changing intensity only as needed, and return the bytes
+// sent, or would be sent when win is NULL
+static uint16_t renderDraw (render_pen_t * pen, window_t * win, const render_item_t * item, uint8_t intensity)
+{
+    uint16_t bytes = 0;
+
+    if (pen->x != item->x || pen->y != item->y) {
+        if (win) draw_abs(win, item->x, item->y);
+        bytes += 4 + digits(item->x, 3) + digits(item->y, 3);       // P[xxx,yyy]
+        pen->x = item->x;
+        pen->y = item->y;
+    }
+
+    if (pen->intensity != intensity) {
+        if (win) draw_intensity(win, (w_intensity_t)intensity);
+        bytes += 7;                                                 // W(I(c))
+        pen->intensity = intensity;
+    }
+
+    switch (item->kind) {
+        case RENDER_CIRCLE:
+            if (win) draw_circle(win, item->radius);
+            bytes += 4 + digits(item->radius, 3);                   // C[+rrr]
+            break;
+        case RENDER_DISC:
+            if (win) draw_circle_fill(win, item->radius);
+            bytes += 11 + digits(item->radius, 3);                  // C(W(S1))[+rrr]
+            break;
+        case RENDER_TEXT:
+            if (win) draw_text(win, (char *)item->text, (uint8_t)item->radius);
+            bytes += 6 + digits(item->radius, 2) + strlen(item->text);  // T(Sss)"text"
+            pen->x = RENDER_UNKNOWN;                                // text moves the pen
+            break;
+    }
+    return bytes;
+}
+
+static uint8_t renderSame (const render_item_t * a, const render_item_t * b)
+{
+    return a->kind == b->kind && a->intensity == b->intensity && a->x == b->x && a->y == b->y &&
+           a->radius == b->radius && (a->kind != RENDER_TEXT || strcmp(a->text, b->text) == 0);
+}
+
+// does drawing or erasing a touch the pixels of b
+static uint8_t renderTouches (const render_item_t * a, const render_item_t * b)
+{
+    int32_t x0, y0, x1, y1, dx, dy, r;
+
+    if (a->kind == RENDER_TEXT) {                                   // bounding box of a, with a pixel to spare
+        x0 = (int32_t)a->x - 1;
+        y0 = (int32_t)a->y - 1;
+        x1 = (int32_t)a->x + (int32_t)strlen(a->text) * RENDER_CELL_X * a->radius + 1;
+        y1 = (int32_t)a->y + RENDER_CELL_Y * a->radius + 1;
+    } else {
+        x0 = (int32_t)a->x - a->radius - 1;
+        y0 = (int32_t)a->y - a->radius - 1;
+        x1 = (int32_t)a->x + a->radius + 1;
+        y1 = (int32_t)a->y + a->radius + 1;
+    }
+
+    if (b->kind == RENDER_TEXT) {
+        return x0 <= (int32_t)b->x + (int32_t)strlen(b->text) * RENDER_CELL_X * b->radius && x1 >= (int32_t)b->x &&
+               y0 <= (int32_t)b->y + RENDER_CELL_Y * b->radius && y1 >= (int32_t)b->y;
+    }
+
+    r = (int32_t)b->radius + 1;
+
+    dx = (int32_t)b->x < x0 ? x0 - b->x : (int32_t)b->x > x1 ? b->x - x1 : 0;  // nearest point of the box
+    dy = (int32_t)b->y < y0 ? y0 - b->y : (int32_t)b->y > y1 ? b->y - y1 : 0;
+    if (dx > r || dy > r || dx*dx + dy*dy > r*r)
+        return 0;                                                   // the box is outside b
+    if (b->kind == RENDER_DISC)
+        return 1;
+
+    r -= 2;
+    if (r <= 0)
+        return 1;
+    dx = (int32_t)b->x - x0 > x1 - (int32_t)b->x ? (int32_t)b->x - x0 : x1 - (int32_t)b->x;     // farthest corner of the box
+    dy = (int32_t)b->y - y0 > y1 - (int32_t)b->y ? (int32_t)b->y - y0 : y1 - (int32_t)b->y;
+    return dx >= r || dy >= r || dx*dx + dy*dy >= r*r;              // the box is not inside the ring
+}
+
+static render_item_t * renderAdd (render_t * render, uint8_t kind, uint16_t x, uint16_t y, uint16_t radius, uint8_t intensity)
+{
+    render_item_t * item;
+
+    if (render->items >= RENDER_ITEMS_MAX)
+        return NULL;
+
+    item = &render->item[render->items++];
+    item->kind = kind;
+    item->intensity = intensity;
+    item->x = x;
+    item->y = y;
+    item->radius = radius;
+    item->text[0] = '\0';
+    return item;
+}
+
+void renderInit ( render_t * render, uint8_t mode )
+{
+    render->mode = mode;
+    render->items = 0;
+    render->itemsLast = 0;
+    render->bytes = 0;
+    render->bytesFull = 0;
+    render->bytesDefine = 0;
+    render->delta = 0;
+    memset(render->macro, 0, sizeof(render->macro));
+}
+
+void renderCircle ( render_t * render, uint16_t x, uint16_t y, uint16_t radius, uint8_t intensity )
+{
+    renderAdd(render, RENDER_CIRCLE, x, y, radius, intensity);
+}
+
+void renderDisc ( render_t * render, uint16_t x, uint16_t y, uint16_t radius, uint8_t intensity )
+{
+    renderAdd(render, RENDER_DISC, x, y, radius, intensity);
+}
+
+void renderText ( render_t * render, uint16_t x, uint16_t y, const char * text, uint8_t size, uint8_t intensity )
+{
+    render_item_t * item = renderAdd(render, RENDER_TEXT, x, y, size, intensity);
+    uint8_t k;
+
+    if (item) {
+        for (k = 0; k < RENDER_TEXT_MAX-1 && text[k]; ++k)
+            item->text[k] = text[k];
+        item->text[k] = '\0';
+    }
+}
+
+void renderSky ( render_t * render, const sky_t * sky, uint16_t day )
+{
+    const render_glyph_t * glyph;
+    uint16_t sun_x, sun_y, x, y;
+    FLOAT orbit, px, py;
+    uint8_t k, g, ring, size;
+    char s[RENDER_TEXT_MAX];
+
+    sun_x = RENDER_CENTRE_X+(int16_t)(sky->sun.x*RENDER_SCALE_AU);
+    sun_y = RENDER_CENTRE_Y-(int16_t)(sky->sun.y*RENDER_SCALE_AU);
+
+    renderDisc( render, RENDER_CENTRE_X, RENDER_CENTRE_Y, 8, _B );                         // earth
+    renderCircle( render, RENDER_CENTRE_X, RENDER_CENTRE_Y, (uint16_t)(sky->sun.au*RENDER_SCALE_AU), _Y );    // sun orbit around earth
+    renderDisc( render, sun_x, sun_y, 18, _Y );                                             // sun
+
+    for (k = 0; k < sky->bodies; ++k) {
+        glyph = &glyphOther;
+        for (g = 0; g < sizeof(glyphs)/sizeof(glyphs[0]); ++g) {
+            if (glyphs[g].planet == sky->planet[k]) {
+                glyph = &glyphs[g];
+                break;
+            }
+        }
+
+        orbit = sky->geo[k].au*glyph->scale;
+        if (orbit < RENDER_RADIUS_MAX) {
+            if (sky->planet[k] == &moon)                                                    // orbit about the earth
+                renderCircle( render, RENDER_CENTRE_X, RENDER_CENTRE_Y, (uint16_t)orbit, glyph->intensity );
+            else                                                                            // orbit about the sun
+                renderCircle( render, sun_x, sun_y, (uint16_t)orbit, glyph->intensity );
+        }
+
+        px = sky->geo[k].x*glyph->scale;
+        py = sky->geo[k].y*glyph->scale;
+        size = glyph->radius + 2*glyph->rings;
+        if (FABS(px) >= RENDER_CENTRE_X + size || FABS(py) >= RENDER_CENTRE_Y + size)
+            continue;                                                                       // off the screen
+
+        x = RENDER_CENTRE_X+(int16_t)px;
+        y = RENDER_CENTRE_Y-(int16_t)py;
+        renderDisc( render, x, y, glyph->radius, glyph->intensity );
+        for (ring = 1; ring <= glyph->rings; ++ring)
+            renderCircle( render, x, y, glyph->radius + 2*ring, glyph->intensity );
+    }
+
+    sprintf(s, "Day: %.4d", day);
+    renderText( render, 10, 450, s, 2, _W );                                               // date
+}
+
+// items in the group from item k, which share its position, or 1 for text
+static uint8_t renderGroup (const render_t * render, uint8_t k)
+{
+    const render_item_t * item = &render->item[k];
+    uint8_t n = 1;
+
+    if (item->kind == RENDER_TEXT)
+        return 1;
+
+    while (n < RENDER_MACRO_ITEMS && k + n < render->items &&
+           item[n].kind != RENDER_TEXT && item[n].x == item->x && item[n].y == item->y)
+        ++n;
+    return n;
+}
+
+#ifndef __Z88DK
+// draw the n items from item k as macrograph g, defining it first if it has changed, and return the
+// bytes sent, or would be sent when win is NULL. The macrograph commands are written straight to the
+// host stand in's stream, as the ReGIS library has no call for them.
+static uint16_t renderMacro (render_t * render, render_pen_t * pen, window_t * win, uint8_t k, uint8_t n, uint8_t g)
+{
+    const render_item_t * item = &render->item[k];
+    render_macro_t * macro = &render->macro[g];
+    render_pen_t body;
+    uint16_t bytes = 0;
+    uint8_t m;
+
+    for (m = 0; m < n; ++m) {
+        if (m >= macro->items || macro->kind[m] != item[m].kind ||
+            macro->intensity[m] != item[m].intensity || macro->radius[m] != item[m].radius)
+            break;
+    }
+
+    if (m < n || macro->items != n) {                               // define the macrograph again
+        body.x = item->x;
+        body.y = item->y;
+        body.intensity = RENDER_UNKNOWN;                            // the macrograph sets its own intensity
+
+        if (win) fprintf(win->fp, "@:%c", 'A' + g);                 // the stand in writes commands as drawn
+        bytes += 3;
+        for (m = 0; m < n; ++m)
+            bytes += renderDraw(&body, win, &item[m], item[m].intensity);
+        if (win) fputs("@;", win->fp);
+        bytes += 2;
+
+        if (win) {
+            macro->items = n;
+            for (m = 0; m < n; ++m) {
+                macro->kind[m] = item[m].kind;
+                macro->intensity[m] = item[m].intensity;
+                macro->radius[m] = item[m].radius;
+            }
+            render->bytesDefine += bytes;
+        }
+    }
+
+    if (pen->x != item->x || pen->y != item->y) {
+        if (win) draw_abs(win, item->x, item->y);
+        bytes += 4 + digits(item->x, 3) + digits(item->y, 3);       // P[xxx,yyy]
+        pen->x = item->x;
+        pen->y = item->y;
+    }
+
+    if (win) fprintf(win->fp, "@%c", 'A' + g);
+    bytes += 2;
+    pen->intensity = item[n-1].intensity;
+    return bytes;
+}
+#endif
+
+// draw the items marked in draw, in list order, a group at a time as its macrograph when every item of
+// the group is marked, and return the bytes sent, or would be sent when win is NULL
+static uint16_t renderItems (render_t * render, render_pen_t * pen, window_t * win, const uint8_t * draw)
+{
+    uint16_t bytes = 0;
+    uint8_t g, k, m, n;
+
+    for (k = 0, g = 0; k < render->items; k += n, ++g) {
+        n = renderGroup(render, k);
+        for (m = 0; m < n && draw[k+m]; ++m)
+            ;
+
+#ifndef __Z88DK
+        if ((render->mode & RENDER_MACRO) && m == n && g < RENDER_MACROS && render->item[k].kind != RENDER_TEXT) {
+            bytes += renderMacro(render, pen, win, k, n, g);
+        } else
+#endif
+        {
+            for (m = 0; m < n; ++m)
+                if (draw[k+m])
+                    bytes += renderDraw(pen, win, &render->item[k+m], render->item[k+m].intensity);
+        }
+    }
+    return bytes;
+}
+
+// the bytes of a full redraw, sent when win is not NULL
+static uint16_t renderFull (render_t * render, window_t * win)
+{
+    render_pen_t pen = render->pen;
+    uint8_t draw[RENDER_ITEMS_MAX];
+
+    memset(draw, 1, sizeof(draw));
+    if (win) window_clear(win);
+    return RENDER_FRAME_BYTES + RENDER_CLEAR_BYTES + renderItems(render, &pen, win, draw);
+}
+
+// the bytes of the changed items drawn as deltas, sent when win is not NULL
+static uint16_t renderDelta (render_t * render, window_t * win, const uint8_t * draw)
+{
+    render_pen_t pen = render->pen;
+    uint16_t bytes = RENDER_FRAME_BYTES;
+    uint8_t k;
+
+    for (k = 0; k < render->items; ++k)
+        if (draw[k] == 1)
+            bytes += renderDraw(&pen, win, &render->last[k], _D);
+    return bytes + renderItems(render, &pen, win, draw);
+}
+
+void renderFrame ( render_t * render, window_t * win )
+{
+    render_pen_t full;
+    uint8_t draw[RENDER_ITEMS_MAX];         // 0 unchanged, 1 changed, 2 unchanged but touched
+    uint8_t j, k;
+
+    full.x = full.y = full.intensity = RENDER_UNKNOWN;              // the library may leave anything behind
+    render->pen = full;
+
+    render->bytesFull = RENDER_FRAME_BYTES + RENDER_CLEAR_BYTES;
+    for (k = 0; k < render->items; ++k)
+        render->bytesFull += renderDraw(&full, NULL, &render->item[k], render->item[k].intensity);
+
+    render->bytesDefine = 0;
+    render->delta = 0;
+
+    if ((render->mode & RENDER_DELTA) && render->items == render->itemsLast) {
+        for (k = 0; k < render->items; ++k)
+            draw[k] = !renderSame(&render->item[k], &render->last[k]);
+
+        for (k = 0; k < render->items; ++k) {
+            if (draw[k] == 1)
+                continue;
+            for (j = 0; j < render->items; ++j) {
+                if (draw[j] == 1 && (renderTouches(&render->last[j], &render->item[k]) ||
+                                     (j < k && renderTouches(&render->item[j], &render->item[k])))) {
+                    draw[k] = 2;                                    // erased, or drawn over, by j
+                    break;
+                }
+            }
+        }
+
+        render->delta = renderDelta(render, NULL, draw) < renderFull(render, NULL);    // erasing costs as much as drawing
+    }
+
+    if (render->delta)
+        render->bytes = renderDelta(render, win, draw);
+    else
+        render->bytes = renderFull(render, win);
+
+    memcpy(render->last, render->item, render->items * sizeof(render_item_t));
+    render->itemsLast = render->items;
+    render->items = 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * planet_motion_render.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_RENDER_H
+#define _PLANET_MOTION_RENDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The render functions need the ReGIS window_t, w_intensity_t and draw_* functions declared first.
+
+// render modes
+
+#define RENDER_FULL     0                   // clear the screen and draw every item, every frame
+#define RENDER_DELTA    1                   // erase and draw only the items changed since the last frame
+#define RENDER_MACRO    2                   // or'd with either, draw items sharing a position as a macrograph (host only)
+
+// draw list sizes
+
+#define RENDER_ITEMS_MAX    24
+#define RENDER_TEXT_MAX     16
+
+// macrographs are named A to Z, and hold the circles and discs drawn at one position
+
+#define RENDER_MACROS       26
+#define RENDER_MACRO_ITEMS  4
+
+// scale of the sky, in pixels per AU, with the Earth at the centre of a 768 x 480 screen
+
+#define RENDER_SCALE_AU     48
+#define RENDER_CENTRE_X     384
+#define RENDER_CENTRE_Y     240
+
+// bodies wholly off the screen, and orbits larger than this radius about a point on it, are not drawn,
+// so no coordinate wraps and the squared distances of items stay within int32_t
+
+#define RENDER_RADIUS_MAX   4096
+
+// item kinds
+
+#define RENDER_CIRCLE   0
+#define RENDER_DISC     1
+#define RENDER_TEXT     2
+
+// bytes of the ReGIS library window_new() and window_close(), and of window_clear()
+
+#define RENDER_FRAME_BYTES  8
+#define RENDER_CLEAR_BYTES  4
+
+// type definitions
+
+typedef struct render_pen_s {       // what the terminal was last told
+    uint16_t x, y;          // pen position, or RENDER_UNKNOWN.
+    uint16_t intensity;     // w_intensity_t, or RENDER_UNKNOWN.
+} render_pen_t;
+
+#define RENDER_UNKNOWN  0xffff
+
+typedef struct render_item_s {      // one primitive of a frame
+    uint8_t kind;           // RENDER_CIRCLE, RENDER_DISC or RENDER_TEXT.
+    uint8_t intensity;      // w_intensity_t of the item.
+    uint16_t x, y;          // pen position, the centre of a circle or the start of text.
+    uint16_t radius;        // radius of a circle, or size of text.
+    char text[RENDER_TEXT_MAX];
+} render_item_t;
+
+typedef struct render_macro_s {     // the items a macrograph was last defined with, by kind, intensity and radius
+    uint8_t items;          // items in the macrograph, or 0 when undefined.
+    uint8_t kind[RENDER_MACRO_ITEMS];
+    uint8_t intensity[RENDER_MACRO_ITEMS];
+    uint16_t radius[RENDER_MACRO_ITEMS];
+} render_macro_t;
+
+typedef struct render_s {           // the draw lists of this frame and the last
+    uint8_t mode;           // RENDER_FULL or RENDER_DELTA, with RENDER_MACRO.
+    uint8_t items;          // items in this frame.
+    uint8_t itemsLast;      // items in the last frame, or 0 before the first frame.
+    render_pen_t pen;       // pen on the terminal.
+    uint8_t delta;          // the last frame was sent as a delta.
+    uint16_t bytes;         // bytes sent for the last frame.
+    uint16_t bytesFull;     // bytes the last frame would take as a full redraw, without macrographs.
+    uint16_t bytesDefine;   // bytes of macrographs defined in the last frame.
+    render_item_t item[RENDER_ITEMS_MAX];
+    render_item_t last[RENDER_ITEMS_MAX];
+    render_macro_t macro[RENDER_MACROS];
+} render_t;
+
+// render functions (C)
+
+// Prepare empty draw lists, to be drawn in mode.
+void renderInit ( render_t * render, uint8_t mode );
+
+// Add an item to this frame, in drawing order.
+void renderCircle ( render_t * render, uint16_t x, uint16_t y, uint16_t radius, uint8_t intensity );
+void renderDisc ( render_t * render, uint16_t x, uint16_t y, uint16_t radius, uint8_t intensity );
+void renderText ( render_t * render, uint16_t x, uint16_t y, const char * text, uint8_t size, uint8_t intensity );
+
+// Add the Earth, the Sun, and every body of sky with its orbit, and the day, to this frame.
+void renderSky ( render_t * render, const sky_t * sky, uint16_t day );
+
+// Draw this frame into an open window, and keep it as the last frame.
+// In RENDER_DELTA mode the items changed from the last frame are erased by drawing them again in _D,
+// unchanged items touched by an erase or overdrawn by a changed item are drawn again, and the changed
+// items are drawn, all in list order, unless a full redraw would be no larger.
+// With RENDER_MACRO the circles and discs drawn at one position are defined as a macrograph, named by
+// their place in the list, and invoked by name. A macrograph is only defined again when an item of it
+// changes intensity or radius, by a pixel or more, and is never used to erase.
+// Macrographs are written past the ReGIS library, so RENDER_MACRO is ignored in z88dk builds until
+// it is checked that the library writes each command as it is drawn, rather than buffering a frame.
+// Counts the bytes sent, and those a full redraw without macrographs would need.
+void renderFrame ( render_t * render, window_t * win );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_RENDER_H  */
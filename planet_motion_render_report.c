@@ -0,0 +1,159 @@
+/*
+ * planet_motion_render_report.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host report of the ReGIS bytes sent per frame of the animation, drawn in full, as deltas,
+    and as deltas with macrographs.
+
+    build and run with:
+
+    make
+    ./planet_motion_render_report [start_day] [days] [baud]
+
+    Each frame is drawn every way into memory sinks, to check the counted bytes against those
+    written, and the frames per second are those of a serial link of baud bits per second, at
+    10 bits per byte.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "planet_motion_regis.h"
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+#include "planet_motion_render.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+#define BAUD                9600
+
+#define MODES               3
+
+static const planet_t * const bodies[] = { &moon, &mercury, &venus, &mars, &jupiter, &saturn };
+
+static const char * const modeNames[MODES] = { "full", "delta", "macro" };
+static const uint8_t modes[MODES] = { RENDER_FULL, RENDER_DELTA, RENDER_DELTA|RENDER_MACRO };
+
+static sky_t sky;
+static render_t render[MODES];
+
+int main (int argc, char ** argv)
+{
+    uint16_t startDay = START_DAY;
+    uint16_t days = DAYS;
+    uint32_t baud = BAUD;
+    uint32_t bytes[MODES] = {0};
+    uint32_t bytesDefine[MODES] = {0};
+    uint16_t bytesMax[MODES] = {0};
+    uint16_t deltas[MODES] = {0};
+    regis_sink_t sink[MODES];
+    window_t window;
+    uint16_t d;
+    uint8_t m;
+
+    if (argc > 1) startDay = (uint16_t)atoi(argv[1]);
+    if (argc > 2) days = (uint16_t)atoi(argv[2]);
+    if (argc > 3) baud = (uint32_t)atol(argv[3]);
+    if (argc > 4 || days == 0 || baud == 0) {
+        fprintf(stderr, "usage: %s [start_day] [days] [baud]\n", argv[0]);
+        return 1;
+    }
+
+    for (m = 0; m < MODES; ++m) {
+        if (!regisSinkOpen(&sink[m], NULL)) {
+            perror("sink");
+            return 1;
+        }
+        renderInit(&render[m], modes[m]);
+    }
+
+    skyInit(&sky, bodies, sizeof(bodies)/sizeof(bodies[0]), startDay, 1.0);
+
+    printf("%6s", "day");
+    for (m = 0; m < MODES; ++m)
+        printf(" %8s", modeNames[m]);
+    printf("\n");
+
+    for (d = startDay; d < startDay + days; ++d) {
+        skyCoordinates(&sky, (FLOAT)d);
+
+        printf("%6u", d);
+        for (m = 0; m < MODES; ++m) {
+            window_new(&window, 768, 480, sink[m].fp);
+            renderSky(&render[m], &sky, d);
+            renderFrame(&render[m], &window);
+            window_close(&window);
+
+            printf(" %8u", render[m].bytes);
+
+            bytes[m] += render[m].bytes;
+            bytesDefine[m] += render[m].bytesDefine;
+            deltas[m] += render[m].delta;
+            if (d != startDay && render[m].bytes > bytesMax[m])
+                bytesMax[m] = render[m].bytes;
+        }
+        printf("\n");
+    }
+
+    printf("\n%-24s", "");
+    for (m = 0; m < MODES; ++m)
+        printf(" %10s", modeNames[m]);
+    printf("\n%-24s", "bytes");
+    for (m = 0; m < MODES; ++m)
+        printf(" %10u", bytes[m]);
+    printf("\n%-24s", "bytes/frame");
+    for (m = 0; m < MODES; ++m)
+        printf(" %10.1f", (double)bytes[m] / days);
+    printf("\n%-24s", "frames/sec");
+    for (m = 0; m < MODES; ++m)
+        printf(" %10.2f", baud / 10.0 / ((double)bytes[m] / days));
+    printf("\n%-24s", "frames sent as deltas");
+    for (m = 0; m < MODES; ++m)
+        printf(" %10u", deltas[m]);
+    printf("\n%-24s", "macrograph bytes");
+    for (m = 0; m < MODES; ++m)
+        printf(" %10u", bytesDefine[m]);
+    if (days > 1) {
+        printf("\n%-24s", "largest later frame");
+        for (m = 0; m < MODES; ++m)
+            printf(" %10u", bytesMax[m]);
+    }
+    printf("\n");
+
+    for (m = 0; m < MODES; ++m) {
+        fflush(sink[m].fp);
+        if (sink[m].size != bytes[m]) {
+            fprintf(stderr, "%s: counted %u bytes, but wrote %zu\n", modeNames[m], bytes[m], sink[m].size);
+            return 1;
+        }
+        regisSinkClose(&sink[m]);
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#include "planet_motion_ring.h"
+
+// The head and tail count slots for ever, wrapping at 2^32, and index the ring modulo slots.
+// Each index is written by one side only: the release store publishes the slot contents with it,
+// and the acquire load on the other side sees them.
+
+uint8_t ringInit ( ring_t * ring, uint32_t slots, uint32_t size )
+{
+    uint32_t n = 1;
+
+    while (n < slots)
+        n <<= 1;
+
+    ring->slots = n;
+    ring->size = size;
+    ring->stalls = 0;
+    ring->starves = 0;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->closed, 0);
+
+    ring->slot = malloc((size_t)n * size);
+    return ring->slot != NULL;
+}
+
+void ringFree ( ring_t * ring )
+{
+    free(ring->slot);
+    ring->slot = NULL;
+}
+
+void * ringProduce ( ring_t * ring )
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+    if (head - atomic_load_explicit(&ring->tail, memory_order_acquire) == ring->slots) {
+        ++ring->stalls;
+        while (head - atomic_load_explicit(&ring->tail, memory_order_acquire) == ring->slots)
+            sched_yield();
+    }
+    return ring->slot + (size_t)(head & (ring->slots - 1)) * ring->size;
+}
+
+void ringPublish ( ring_t * ring )
+{
+    atomic_store_explicit(&ring->head, atomic_load_explicit(&ring->head, memory_order_relaxed) + 1, memory_order_release);
+}
+
+void ringClose ( ring_t * ring )
+{
+    atomic_store_explicit(&ring->closed, 1, memory_order_release);
+}
+
+void * ringConsume ( ring_t * ring )
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    if (atomic_load_explicit(&ring->head, memory_order_acquire) == tail) {
+        ++ring->starves;
+        while (atomic_load_explicit(&ring->head, memory_order_acquire) == tail) {
+            if (atomic_load_explicit(&ring->closed, memory_order_acquire) &&
+                atomic_load_explicit(&ring->head, memory_order_acquire) == tail)
+                return NULL;
+            sched_yield();
+        }
+    }
+    return ring->slot + (size_t)(tail & (ring->slots - 1)) * ring->size;
+}
+
+void ringRelease ( ring_t * ring )
+{
+    atomic_store_explicit(&ring->tail, atomic_load_explicit(&ring->tail, memory_order_relaxed) + 1, memory_order_release);
+}
+
+uint32_t ringReady ( ring_t * ring )
+{
+    return atomic_load_explicit(&ring->head, memory_order_acquire) - atomic_load_explicit(&ring->tail, memory_order_relaxed);
+}
@@ -0,0 +1,78 @@
+/*
+ * planet_motion_ring.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_RING_H
+#define _PLANET_MOTION_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host (gcc, clang) single producer, single consumer ring of fixed size slots, without locks.
+// The producer fills a slot in place and publishes it, the consumer reads it in place and releases it,
+// and each waits, yielding, while the ring is full or empty, which is the back pressure between them.
+
+#define RING_CACHE_LINE     64
+
+// type definitions
+
+typedef struct ring_s {
+    uint8_t * slot;         // slots * size bytes.
+    uint32_t slots;         // slots in the ring, a power of 2.
+    uint32_t size;          // bytes per slot.
+    _Alignas(RING_CACHE_LINE) _Atomic uint32_t head;    // slots published, written by the producer.
+    uint32_t stalls;        // times the producer waited on a full ring.
+    _Alignas(RING_CACHE_LINE) _Atomic uint32_t tail;    // slots released, written by the consumer.
+    uint32_t starves;       // times the consumer waited on an empty ring.
+    _Alignas(RING_CACHE_LINE) _Atomic uint8_t closed;   // the producer has published its last slot.
+} ring_t;
+
+// ring functions (C)
+
+// Allocate a ring of slots (rounded up to a power of 2) of size bytes, returning 0 on failure.
+uint8_t ringInit ( ring_t * ring, uint32_t slots, uint32_t size );
+void ringFree ( ring_t * ring );
+
+// Producer: the next free slot, waiting while the ring is full, to be filled and then published.
+void * ringProduce ( ring_t * ring );
+void ringPublish ( ring_t * ring );
+void ringClose ( ring_t * ring );
+
+// Consumer: the next published slot, waiting while the ring is empty, or NULL once the ring is closed
+// and empty, to be read and then released.
+void * ringConsume ( ring_t * ring );
+void ringRelease ( ring_t * ring );
+
+// Consumer: slots published and not yet consumed.
+uint32_t ringReady ( ring_t * ring );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_RING_H  */
@@ -0,0 +1,417 @@
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_apu.h"
+#include "planet_motion_sched.h"
+#include "multi_apu.h"
+
+#define NONE        0xff
+#define Z80         0xfe                    // a value held by the Z80
+
+typedef struct sched_state_s {      // the simulated Z80 and APUs
+    uint64_t now;
+    uint64_t ready[APU_UNITS];
+    uint8_t tos[APU_UNITS];         // node on the top of each stack, or NONE.
+    uint8_t where[SCHED_NODES_MAX]; // unit holding each node, Z80, or NONE before it is computed.
+    uint8_t uses[SCHED_NODES_MAX];  // uses of each node yet to be scheduled.
+} sched_state_t;
+
+// Z80 T-states of an APU opcode
+static uint32_t cycles (uint8_t op)
+{
+    return (uint32_t)((uint64_t)apuOpCycles[op] * APU_Z80_CLOCK / APU_CLOCK);
+}
+
+// the timing of planet_motion_apu.c
+static void simWait (sched_state_t * state, uint8_t u)
+{
+    if (state->now < state->ready[u])
+        state->now = state->ready[u];
+}
+
+static void simPush (sched_state_t * state, uint8_t u)
+{
+    simWait(state, u);
+    state->ready[u] = state->now + cycles(APU_PUSH);
+    state->now += APU_Z80_PUSH;
+}
+
+static void simCommand (sched_state_t * state, uint8_t u, uint8_t op)
+{
+    simWait(state, u);
+    state->now += APU_Z80_COMMAND;
+    state->ready[u] = state->now + cycles(op);
+}
+
+static uint8_t emit (sched_t * sched, sched_state_t * state, uint8_t call, uint8_t u, uint8_t value, uint8_t negate)
+{
+    sched_step_t * step;
+
+    if (sched->steps >= SCHED_STEPS_MAX)
+        return 0;
+
+    step = &sched->step[sched->steps++];
+    step->call = call;
+    step->unit = u;
+    step->value = value;
+    step->negate = negate;
+
+    switch (call) {
+        case SCHED_PUSH:    simPush(state, u); break;
+        case SCHED_POP:
+            simWait(state, u);
+            state->ready[u] = state->now + cycles(APU_POP);
+            state->now += APU_Z80_POP;
+            break;
+        case SCHED_FADD:    simPush(state, u); simCommand(state, u, APU_FADD); break;
+        case SCHED_FMUL:    simPush(state, u); simCommand(state, u, APU_FMUL); break;
+        case SCHED_FDIV:    simPush(state, u); simCommand(state, u, APU_FDIV); break;
+        case SCHED_FSIN:    simCommand(state, u, APU_SIN); break;
+        case SCHED_FCOS:    simCommand(state, u, APU_COS); break;
+        case SCHED_FRAD:    simPush(state, u); simPush(state, u); simCommand(state, u, APU_FMUL); break;
+        case SCHED_FRADTOS:
+        case SCHED_FDEG:    simPush(state, u); simCommand(state, u, APU_FMUL); break;
+    }
+    return 1;
+}
+
+// pop the value on unit u to the Z80
+static uint8_t popUnit (sched_t * sched, sched_state_t * state, uint8_t u)
+{
+    uint8_t n = state->tos[u];
+
+    state->where[n] = Z80;
+    state->tos[u] = NONE;
+    return emit(sched, state, SCHED_POP, u, n, 0);
+}
+
+// estimated Z80 T-states of a node, with its operand pushes
+static uint32_t cost (uint8_t op)
+{
+    switch (op) {
+        case SCHED_ADD:
+        case SCHED_SUB: return APU_Z80_PUSH + APU_Z80_COMMAND + cycles(APU_FADD);
+        case SCHED_MUL: return APU_Z80_PUSH + APU_Z80_COMMAND + cycles(APU_FMUL);
+        case SCHED_DIV: return APU_Z80_PUSH + APU_Z80_COMMAND + cycles(APU_FDIV);
+        case SCHED_SIN: return APU_Z80_COMMAND + cycles(APU_SIN);
+        case SCHED_COS: return APU_Z80_COMMAND + cycles(APU_COS);
+        case SCHED_RAD:
+        case SCHED_DEG: return APU_Z80_PUSH + APU_Z80_COMMAND + cycles(APU_FMUL);
+    }
+    return 0;
+}
+
+void schedGraphInit ( sched_graph_t * graph )
+{
+    graph->nodes = 0;
+}
+
+static uint8_t addNode (sched_graph_t * graph, uint8_t op, uint8_t a, uint8_t b, FLOAT value, const char * name)
+{
+    sched_node_t * node;
+
+    if (graph->nodes >= SCHED_NODES_MAX || (op > SCHED_CONST && a >= graph->nodes) || (op >= SCHED_ADD && op <= SCHED_DIV && b >= graph->nodes))
+        return NONE;
+
+    node = &graph->node[graph->nodes];
+    node->op = op;
+    node->a = a;
+    node->b = b;
+    node->output = 0;
+    node->value = value;
+    node->name[0] = '\0';
+    if (name) {
+        strncpy(node->name, name, SCHED_NAME_MAX);
+        node->name[SCHED_NAME_MAX-1] = '\0';
+    }
+    return graph->nodes++;
+}
+
+uint8_t schedInput ( sched_graph_t * graph, const char * name )
+{
+    return addNode(graph, SCHED_INPUT, NONE, NONE, 0.0, name);
+}
+
+uint8_t schedConst ( sched_graph_t * graph, FLOAT value )
+{
+    return addNode(graph, SCHED_CONST, NONE, NONE, value, NULL);
+}
+
+uint8_t schedOp ( sched_graph_t * graph, uint8_t op, uint8_t a, uint8_t b )
+{
+    if (op < SCHED_ADD || op > SCHED_DEG)
+        return NONE;
+    return addNode(graph, op, a, (op <= SCHED_DIV) ? b : NONE, 0.0, NULL);
+}
+
+void schedOutput ( sched_graph_t * graph, uint8_t node, const char * name )
+{
+    if (node < graph->nodes) {
+        graph->node[node].output = 1;
+        strncpy(graph->node[node].name, name, SCHED_NAME_MAX);
+        graph->node[node].name[SCHED_NAME_MAX-1] = '\0';
+    }
+}
+
+uint8_t schedSinD ( sched_graph_t * graph, uint8_t a )
+{
+    return schedOp(graph, SCHED_SIN, schedOp(graph, SCHED_RAD, a, NONE), NONE);
+}
+
+uint8_t schedCosD ( sched_graph_t * graph, uint8_t a )
+{
+    return schedOp(graph, SCHED_COS, schedOp(graph, SCHED_RAD, a, NONE), NONE);
+}
+
+uint8_t schedBuild ( sched_t * sched, const sched_graph_t * graph, uint8_t units )
+{
+    const sched_node_t * node = graph->node;
+    sched_state_t state;
+    uint32_t priority[SCHED_NODES_MAX];
+    uint8_t live[SCHED_NODES_MAX];
+    uint8_t n, k, u, best, left, right, chain, remaining = 0;
+
+    if (units == 0 || units > APU_UNITS)
+        return 0;
+
+    sched->graph = graph;
+    sched->units = units;
+    sched->steps = 0;
+    memset(&state, 0, sizeof(state));
+    memset(state.tos, NONE, sizeof(state.tos));
+    memset(state.uses, 0, sizeof(state.uses));
+
+    // live nodes, their uses, and the longest path from each to an output, from the last node back
+
+    for (n = graph->nodes; n-- > 0; ) {
+        live[n] = node[n].output;
+        priority[n] = node[n].output ? APU_Z80_POP : 0;
+        for (k = n + 1; k < graph->nodes; ++k) {
+            if (live[k] && node[k].op > SCHED_CONST && (node[k].a == n || node[k].b == n)) {
+                live[n] = 1;
+                state.uses[n] += (node[k].a == n) + (node[k].b == n);
+                if (priority[k] > priority[n])
+                    priority[n] = priority[k];
+            }
+        }
+        priority[n] += cost(node[n].op);
+        state.where[n] = (node[n].op <= SCHED_CONST) ? Z80 : NONE;
+        remaining += live[n] && node[n].op > SCHED_CONST;
+    }
+
+    // list schedule, the ready node with the longest path first
+
+    while (remaining--) {
+        best = NONE;
+        for (n = 0; n < graph->nodes; ++n) {
+            if (!live[n] || state.where[n] != NONE || state.where[node[n].a] == NONE ||
+                (node[n].op <= SCHED_DIV && state.where[node[n].b] == NONE))
+                continue;
+            if (best == NONE || priority[n] > priority[best])
+                best = n;
+        }
+        if (best == NONE)
+            return 0;
+
+        left = node[best].a;
+        right = node[best].b;
+
+#define CHAINABLE(x)    (state.where[x] < APU_UNITS && state.uses[x] == 1 && !node[x].output)
+
+        if ((node[best].op == SCHED_ADD || node[best].op == SCHED_MUL) && CHAINABLE(right) &&
+            (!CHAINABLE(left) || state.ready[state.where[right]] > state.ready[state.where[left]])) {
+            left = node[best].b;                                    // chain on the operand done last
+            right = node[best].a;
+        }
+        chain = CHAINABLE(left);
+
+        if (node[best].op <= SCHED_DIV && state.where[right] < APU_UNITS && !popUnit(sched, &state, state.where[right]))
+            return 0;                                               // the right operand comes from the Z80
+        if (!chain && state.where[left] < APU_UNITS && !popUnit(sched, &state, state.where[left]))
+            return 0;
+
+        if (chain) {
+            u = state.where[left];
+        } else {
+            u = NONE;
+            for (k = 0; k < units; ++k)                             // the empty unit free soonest
+                if (state.tos[k] == NONE && (u == NONE || state.ready[k] < state.ready[u]))
+                    u = k;
+            if (u == NONE) {                                        // or pop the unit free soonest
+                for (u = 0, k = 1; k < units; ++k)
+                    if (state.ready[k] < state.ready[u])
+                        u = k;
+                if (!popUnit(sched, &state, u))
+                    return 0;
+            }
+        }
+
+        switch (node[best].op) {
+            case SCHED_ADD:
+            case SCHED_SUB:
+            case SCHED_MUL:
+            case SCHED_DIV:
+                if (!chain && !emit(sched, &state, SCHED_PUSH, u, left, 0))
+                    return 0;
+                if (!emit(sched, &state, node[best].op == SCHED_MUL ? SCHED_FMUL : node[best].op == SCHED_DIV ? SCHED_FDIV : SCHED_FADD,
+                          u, right, node[best].op == SCHED_SUB))
+                    return 0;
+                --state.uses[right];
+                break;
+            case SCHED_RAD:
+                if (!emit(sched, &state, chain ? SCHED_FRADTOS : SCHED_FRAD, u, left, 0))
+                    return 0;
+                break;
+            default:
+                if (!chain && !emit(sched, &state, SCHED_PUSH, u, left, 0))
+                    return 0;
+                if (!emit(sched, &state, node[best].op == SCHED_SIN ? SCHED_FSIN : node[best].op == SCHED_COS ? SCHED_FCOS : SCHED_FDEG, u, NONE, 0))
+                    return 0;
+                break;
+        }
+        --state.uses[left];
+
+        state.where[best] = u;
+        state.tos[u] = best;
+    }
+
+    for (n = 0; n < graph->nodes; ++n)                              // pop the outputs left on the units
+        if (node[n].output && state.where[n] < APU_UNITS && !popUnit(sched, &state, state.where[n]))
+            return 0;
+
+    sched->latency = (uint32_t)state.now;
+    return 1;
+}
+
+void schedRun ( const sched_t * sched, const FLOAT * input, FLOAT * output )
+{
+    static void (* const push[APU_UNITS])(float) = { push_0, push_1, push_2, push_3 };
+    static float (* const pop[APU_UNITS])(void) = { pop_0, pop_1, pop_2, pop_3 };
+    static void (* const add[APU_UNITS])(float) = { add_0, add_1, add_2, add_3 };
+    static void (* const mul[APU_UNITS])(float) = { mul_0, mul_1, mul_2, mul_3 };
+    static void (* const div[APU_UNITS])(float) = { div_0, div_1, div_2, div_3 };
+    static void (* const sin[APU_UNITS])(void) = { sin_0, sin_1, sin_2, sin_3 };
+    static void (* const cos[APU_UNITS])(void) = { cos_0, cos_1, cos_2, cos_3 };
+    static void (* const rad[APU_UNITS])(float) = { rad_0, rad_1, rad_2, rad_3 };
+    static void (* const deg[APU_UNITS])(void) = { deg_0, deg_1, deg_2, deg_3 };
+
+    const sched_graph_t * graph = sched->graph;
+    FLOAT value[SCHED_NODES_MAX];
+    const sched_step_t * step;
+    FLOAT x;
+    uint16_t s;
+    uint8_t n;
+
+    for (n = 0; n < graph->nodes; ++n) {
+        if (graph->node[n].op == SCHED_INPUT)
+            value[n] = *input++;
+        else if (graph->node[n].op == SCHED_CONST)
+            value[n] = graph->node[n].value;
+    }
+
+    for (s = 0, step = sched->step; s < sched->steps; ++s, ++step) {
+        x = (step->value < SCHED_NODES_MAX) ? (step->negate ? -value[step->value] : value[step->value]) : 0.0;
+
+        switch (step->call) {
+            case SCHED_PUSH:    push[step->unit](x); break;
+            case SCHED_POP:     value[step->value] = pop[step->unit](); break;
+            case SCHED_FADD:    add[step->unit](x); break;
+            case SCHED_FMUL:    mul[step->unit](x); break;
+            case SCHED_FDIV:    div[step->unit](x); break;
+            case SCHED_FSIN:    sin[step->unit](); break;
+            case SCHED_FCOS:    cos[step->unit](); break;
+            case SCHED_FRAD:    rad[step->unit](x); break;
+            case SCHED_FRADTOS: mul[step->unit](M_PI/180.0); break;
+            case SCHED_FDEG:    deg[step->unit](); break;
+        }
+    }
+
+    for (n = 0; n < graph->nodes; ++n)
+        if (graph->node[n].output)
+            *output++ = value[n];
+}
+
+// the C expression of a node's value
+static void writeValue (FILE * fp, const sched_graph_t * graph, uint8_t n, uint8_t negate)
+{
+    const sched_node_t * node = &graph->node[n];
+
+    if (node->op == SCHED_CONST)
+        fprintf(fp, "%.9g", negate ? -node->value : node->value);
+    else if (node->op == SCHED_INPUT)
+        fprintf(fp, "%s%s", negate ? "-" : "", node->name);
+    else
+        fprintf(fp, "%sv%u", negate ? "-" : "", n);
+}
+
+void schedWriteC ( FILE * fp, const sched_t * sched, const char * name )
+{
+    static const char * const calls[] = { "push", "pop", "add", "mul", "div", "sin", "cos", "rad", "mul", "deg" };
+
+    const sched_graph_t * graph = sched->graph;
+    const sched_step_t * step;
+    uint8_t n, first = 1;
+    uint16_t s;
+
+    fprintf(fp, "// %u multi_apu.h calls on %u APUs, %u T-states predicted\n", sched->steps, sched->units, sched->latency);
+    fprintf(fp, "void %s (", name);
+    for (n = 0; n < graph->nodes; ++n) {
+        if (graph->node[n].op == SCHED_INPUT) {
+            fprintf(fp, "%s FLOAT %s", first ? "" : ",", graph->node[n].name);
+            first = 0;
+        }
+    }
+    for (n = 0; n < graph->nodes; ++n) {
+        if (graph->node[n].output) {
+            fprintf(fp, "%s FLOAT * %s", first ? "" : ",", graph->node[n].name);
+            first = 0;
+        }
+    }
+    fprintf(fp, " )\n{\n");
+
+    for (n = 0; n < graph->nodes; ++n) {
+        for (s = 0; s < sched->steps; ++s) {
+            if (sched->step[s].call == SCHED_POP && sched->step[s].value == n) {
+                fprintf(fp, "    FLOAT v%u;\n", n);
+                break;
+            }
+        }
+    }
+    fprintf(fp, "\n");
+
+    for (s = 0, step = sched->step; s < sched->steps; ++s, ++step) {
+        fprintf(fp, "    ");
+        switch (step->call) {
+            case SCHED_POP:
+                fprintf(fp, "v%u = pop_%u();\n", step->value, step->unit);
+                break;
+            case SCHED_FSIN:
+            case SCHED_FCOS:
+            case SCHED_FDEG:
+                fprintf(fp, "%s_%u();\n", calls[step->call], step->unit);
+                break;
+            case SCHED_FRADTOS:
+                fprintf(fp, "mul_%u(M_PI/180.0);\n", step->unit);
+                break;
+            default:
+                fprintf(fp, "%s_%u(", calls[step->call], step->unit);
+                writeValue(fp, graph, step->value, step->negate);
+                fprintf(fp, ");\n");
+                break;
+        }
+    }
+
+    fprintf(fp, "\n");
+    for (n = 0; n < graph->nodes; ++n) {
+        if (graph->node[n].output) {
+            fprintf(fp, "    *%s = ", graph->node[n].name);
+            writeValue(fp, graph, n, 0);
+            fprintf(fp, ";\n");
+        }
+    }
+    fprintf(fp, "}\n");
+}
@@ -0,0 +1,136 @@
+/*
+ * planet_motion_sched.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_SCHED_H
+#define _PLANET_MOTION_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host (gcc, clang) dataflow scheduler for the multi_apu.h functions.
+//
+// A computation is described as a graph of nodes, from inputs and constants through arithmetic and
+// trigonometry to outputs, and a list scheduler assigns each operation to one of the APUs, in order
+// of the longest path (in Am9511A and Z80 time) from it to an output. An operation chains on the unit
+// holding its left operand when it is that value's only use, and otherwise takes the unit free soonest,
+// as the right operand of add_N(), mul_N() and div_N() always comes from the Z80. Values needed more
+// than once are popped when they are first needed. The timing is that of planet_motion_apu.h.
+//
+// The schedule is a sequence of multi_apu.h calls, to be run by schedRun() or written out as C.
+
+#define SCHED_NODES_MAX     96
+#define SCHED_STEPS_MAX     384
+#define SCHED_NAME_MAX      16
+
+// node operations
+
+#define SCHED_INPUT     0
+#define SCHED_CONST     1
+#define SCHED_ADD       2
+#define SCHED_SUB       3
+#define SCHED_MUL       4
+#define SCHED_DIV       5
+#define SCHED_SIN       6       // of radians
+#define SCHED_COS       7
+#define SCHED_RAD       8       // degrees to radians
+#define SCHED_DEG       9       // radians to degrees
+
+// calls of a schedule, as multi_apu.h
+
+#define SCHED_PUSH      0       // push_N(value)
+#define SCHED_POP       1       // value = pop_N()
+#define SCHED_FADD      2       // add_N(value), or add_N(-value)
+#define SCHED_FMUL      3       // mul_N(value)
+#define SCHED_FDIV      4       // div_N(value)
+#define SCHED_FSIN      5       // sin_N()
+#define SCHED_FCOS      6       // cos_N()
+#define SCHED_FRAD      7       // rad_N(value)
+#define SCHED_FRADTOS   8       // mul_N(M_PI/180.0), rad of the top of stack
+#define SCHED_FDEG      9       // deg_N()
+
+// type definitions
+
+typedef struct sched_node_s {
+    uint8_t op;
+    uint8_t a, b;           // operands, b for the arithmetic only.
+    uint8_t output;         // this node is an output.
+    FLOAT value;            // of a constant.
+    char name[SCHED_NAME_MAX];  // of an input or output.
+} sched_node_t;
+
+typedef struct sched_graph_s {
+    uint8_t nodes;
+    sched_node_t node[SCHED_NODES_MAX];
+} sched_graph_t;
+
+typedef struct sched_step_s {
+    uint8_t call;           // SCHED_PUSH to SCHED_FDEG.
+    uint8_t unit;
+    uint8_t value;          // node whose value is the argument, or is popped.
+    uint8_t negate;         // the argument is negated.
+} sched_step_t;
+
+typedef struct sched_s {
+    const sched_graph_t * graph;
+    uint8_t units;
+    uint16_t steps;
+    sched_step_t step[SCHED_STEPS_MAX];
+    uint32_t latency;       // predicted Z80 T-states, from the first call to the last pop.
+} sched_t;
+
+// graph functions (C)
+
+void schedGraphInit ( sched_graph_t * graph );
+
+// Add a node, returning its index, or 0xff when the graph is full.
+uint8_t schedInput ( sched_graph_t * graph, const char * name );
+uint8_t schedConst ( sched_graph_t * graph, FLOAT value );
+uint8_t schedOp ( sched_graph_t * graph, uint8_t op, uint8_t a, uint8_t b );
+void schedOutput ( sched_graph_t * graph, uint8_t node, const char * name );
+
+// sin and cos of degrees
+uint8_t schedSinD ( sched_graph_t * graph, uint8_t a );
+uint8_t schedCosD ( sched_graph_t * graph, uint8_t a );
+
+// schedule functions (C)
+
+// Schedule graph onto units APUs (1 to 4), returning 0 when it does not fit.
+uint8_t schedBuild ( sched_t * sched, const sched_graph_t * graph, uint8_t units );
+
+// Run the schedule with the multi_apu.h functions, from the inputs, in node order, to the outputs.
+void schedRun ( const sched_t * sched, const FLOAT * input, FLOAT * output );
+
+// Write the schedule as a C function of the inputs, returning the outputs through pointers.
+void schedWriteC ( FILE * fp, const sched_t * sched, const char * name );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_SCHED_H  */
@@ -0,0 +1,310 @@
+/*
+ * planet_motion_sched_gen.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host scheduling of planet_motion computations onto the multi_apu.h APUs.
+
+    build and run with:
+
+    make
+    ./planet_motion_sched_gen [start_day] [days]
+    ./planet_motion_sched_gen -c graph [-u units]
+
+    Three graphs are scheduled onto 1 to 4 emulated Am9511A APUs by planet_motion_sched.c:
+    planet, the tail of planetEclipticCartesianCoordinates() from the eccentric anomaly on,
+    sun, the equation of centre of sunEclipticCartesianCoordinates(), and kepler, one Newton
+    step of eccentricAnomaly(). Each schedule is run over the days for every planet, reporting
+    the predicted and emulated Z80 T-states, the speedup over one APU, and the largest difference
+    from the graph evaluated in double (and for planet, from planetEclipticCartesianCoordinates()).
+
+    With -c the schedule of the graph is written out as a C function of the multi_apu.h calls.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_apu.h"
+#include "planet_motion_sched.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                366
+
+#define GRAPH_PLANET        0
+#define GRAPH_SUN           1
+#define GRAPH_KEPLER        2
+#define GRAPHS              3
+
+#define INPUTS_MAX          8
+#define OUTPUTS_MAX         4
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+
+static sched_graph_t graph[GRAPHS];
+static sched_t sched;
+
+static const char * const graphNames[GRAPHS] = { "planet", "sun", "kepler" };
+static const char * const functionNames[GRAPHS] = { "apuPlanetTail", "apuSunCentre", "apuKeplerStep" };
+
+// x, y and z from N, i, w, E, e, a and sqrt(1-e*e), as planetStepperEclipticCartesianCoordinates()
+static void planetGraph (sched_graph_t * g)
+{
+    uint8_t N, i, w, E, e, a, sqrte;
+    uint8_t sinE, cosE, sinw, cosw, sinN, cosN, sini, cosi, xv, yv, rcosVW, rsinVW, rsinVWcosi;
+
+    schedGraphInit(g);
+    N = schedInput(g, "N");
+    i = schedInput(g, "i");
+    w = schedInput(g, "w");
+    E = schedInput(g, "E");
+    e = schedInput(g, "e");
+    a = schedInput(g, "a");
+    sqrte = schedInput(g, "sqrte");
+
+    sinE = schedSinD(g, E);
+    cosE = schedCosD(g, E);
+    sinw = schedSinD(g, w);
+    cosw = schedCosD(g, w);
+    sinN = schedSinD(g, N);
+    cosN = schedCosD(g, N);
+    sini = schedSinD(g, i);
+    cosi = schedCosD(g, i);
+
+    xv = schedOp(g, SCHED_MUL, a, schedOp(g, SCHED_SUB, cosE, e));
+    yv = schedOp(g, SCHED_MUL, schedOp(g, SCHED_MUL, a, sqrte), sinE);
+
+    rcosVW = schedOp(g, SCHED_SUB, schedOp(g, SCHED_MUL, xv, cosw), schedOp(g, SCHED_MUL, yv, sinw));
+    rsinVW = schedOp(g, SCHED_ADD, schedOp(g, SCHED_MUL, yv, cosw), schedOp(g, SCHED_MUL, xv, sinw));
+    rsinVWcosi = schedOp(g, SCHED_MUL, rsinVW, cosi);
+
+    schedOutput(g, schedOp(g, SCHED_SUB, schedOp(g, SCHED_MUL, cosN, rcosVW), schedOp(g, SCHED_MUL, sinN, rsinVWcosi)), "x");
+    schedOutput(g, schedOp(g, SCHED_ADD, schedOp(g, SCHED_MUL, sinN, rcosVW), schedOp(g, SCHED_MUL, cosN, rsinVWcosi)), "y");
+    schedOutput(g, schedOp(g, SCHED_MUL, rsinVW, sini), "z");
+}
+
+// the Sun's equation of centre C from M0, and the coefficients of sin(M0), sin(2*M0) and sin(3*M0)
+static void sunGraph (sched_graph_t * g)
+{
+    uint8_t M, c1, c2, c3;
+
+    schedGraphInit(g);
+    M = schedInput(g, "M");
+    c1 = schedInput(g, "c1");
+    c2 = schedInput(g, "c2");
+    c3 = schedInput(g, "c3");
+
+    schedOutput(g, schedOp(g, SCHED_ADD,
+                    schedOp(g, SCHED_ADD,
+                        schedOp(g, SCHED_MUL, c1, schedSinD(g, M)),
+                        schedOp(g, SCHED_MUL, c2, schedSinD(g, schedOp(g, SCHED_MUL, M, schedConst(g, 2.0))))),
+                    schedOp(g, SCHED_MUL, c3, schedSinD(g, schedOp(g, SCHED_MUL, M, schedConst(g, 3.0))))), "C");
+}
+
+// one Newton step of eccentricAnomaly(), E - (E - DEG(e*sin(E)) - M) / (1 - e*cos(E))
+static void keplerGraph (sched_graph_t * g)
+{
+    uint8_t E, e, M, error;
+
+    schedGraphInit(g);
+    E = schedInput(g, "E");
+    e = schedInput(g, "e");
+    M = schedInput(g, "M");
+
+    error = schedOp(g, SCHED_DIV,
+                schedOp(g, SCHED_SUB,
+                    schedOp(g, SCHED_SUB, E, schedOp(g, SCHED_DEG, schedOp(g, SCHED_MUL, e, schedSinD(g, E)), 0)),
+                    M),
+                schedOp(g, SCHED_SUB, schedConst(g, 1.0), schedOp(g, SCHED_MUL, e, schedCosD(g, E))));
+
+    schedOutput(g, schedOp(g, SCHED_SUB, E, error), "E1");
+}
+
+// the graph evaluated in double, the reference for the schedules
+static void evaluate (const sched_graph_t * g, const FLOAT * input, double * output)
+{
+    double value[SCHED_NODES_MAX];
+    const sched_node_t * node;
+    uint8_t n;
+
+    for (n = 0, node = g->node; n < g->nodes; ++n, ++node) {
+        switch (node->op) {
+            case SCHED_INPUT:   value[n] = *input++; break;
+            case SCHED_CONST:   value[n] = node->value; break;
+            case SCHED_ADD:     value[n] = value[node->a] + value[node->b]; break;
+            case SCHED_SUB:     value[n] = value[node->a] - value[node->b]; break;
+            case SCHED_MUL:     value[n] = value[node->a] * value[node->b]; break;
+            case SCHED_DIV:     value[n] = value[node->a] / value[node->b]; break;
+            case SCHED_SIN:     value[n] = sin(value[node->a]); break;
+            case SCHED_COS:     value[n] = cos(value[node->a]); break;
+            case SCHED_RAD:     value[n] = value[node->a] * (M_PI/180.0); break;
+            case SCHED_DEG:     value[n] = value[node->a] * (180.0/M_PI); break;
+        }
+        if (node->output)
+            *output++ = value[n];
+    }
+}
+
+// the inputs of a graph for a body and day
+static void inputs (uint8_t g, uint8_t p, FLOAT day, FLOAT * input)
+{
+    const planet_t * planet = planets[p];
+    FLOAT T, e, M;
+
+    switch (g) {
+        case GRAPH_SUN:
+            T = (day - 1.5) * 0.0000273785;
+            input[0] = rev(357.52910 + (35999.05030 * T) - (0.0001559 * SQR(T)) - (0.00000048 * T * SQR(T)));
+            input[1] = 1.914600 - 0.004817 * T - 0.000014 * SQR(T);
+            input[2] = 0.01993 - 0.000101 * T;
+            input[3] = 0.000290;
+            break;
+
+        case GRAPH_PLANET:
+            e = planet->e0 + day * planet->ec;
+            input[0] = rev(planet->N0 + day * planet->Nc);
+            input[1] = rev(planet->i0 + day * planet->ic);
+            input[2] = rev(planet->w0 + day * planet->wc);
+            input[3] = rev(eccentricAnomaly(e, rev(planet->M0 + day * planet->Mc)));
+            input[4] = e;
+            input[5] = planet->a0 + day * planet->ac;
+            input[6] = SQRT(1.0 - SQR(e));
+            break;
+
+        default:
+            e = planet->e0 + day * planet->ec;
+            M = rev(planet->M0 + day * planet->Mc);
+            input[0] = M + DEG(e * SIND(M) * (1.0 + (e * COSD(M))));   // the starting guess of eccentricAnomaly()
+            input[1] = e;
+            input[2] = M;
+            break;
+    }
+}
+
+static void report (uint8_t g, uint8_t units, uint32_t single)
+{
+    FLOAT input[INPUTS_MAX], output[OUTPUTS_MAX];
+    double reference[OUTPUTS_MAX];
+    cartesian_coordinates_t location;
+    double error = 0.0, errorFns = 0.0;
+    uint64_t emulated = 0;
+    uint32_t runs = 0;
+    uint16_t d, pops = 0, s;
+    uint8_t p, k, outputs = 0;
+    uint8_t bodies = (g == GRAPH_SUN) ? 1 : PLANETS - 1;
+
+    if (!schedBuild(&sched, &graph[g], units)) {
+        printf("%-8s %5u does not fit\n", graphNames[g], units);
+        return;
+    }
+    for (s = 0; s < sched.steps; ++s)
+        pops += sched.step[s].call == SCHED_POP;
+    for (k = 0; k < graph[g].nodes; ++k)
+        outputs += graph[g].node[k].output;
+
+    for (d = 0; d < days; ++d) {
+        for (p = 1; p <= bodies; ++p) {
+            inputs(g, p, startDay + d, input);
+
+            apuReset();
+            schedRun(&sched, input, output);
+            emulated += apu.now;
+            ++runs;
+
+            evaluate(&graph[g], input, reference);
+            for (k = 0; k < outputs; ++k)
+                if (fabs(output[k] - reference[k]) > error)
+                    error = fabs(output[k] - reference[k]);
+
+            if (g == GRAPH_PLANET) {
+                location.day = startDay + d;
+                planetEclipticCartesianCoordinates(&location, planets[p]);
+                if (fabs(output[0] - location.x) > errorFns) errorFns = fabs(output[0] - location.x);
+                if (fabs(output[1] - location.y) > errorFns) errorFns = fabs(output[1] - location.y);
+                if (fabs(output[2] - location.z) > errorFns) errorFns = fabs(output[2] - location.z);
+            }
+        }
+    }
+
+    printf("%-8s %5u %6u %5u %10u %10.0f %8.2f %8.2f %10.2e", graphNames[g], units, sched.steps, pops,
+           sched.latency, (double)emulated / runs, sched.latency * 1.0e3 / APU_Z80_CLOCK, (double)single / sched.latency, error);
+    if (g == GRAPH_PLANET)
+        printf(" %10.2e", errorFns);
+    printf("\n");
+}
+
+int main (int argc, char ** argv)
+{
+    const char * name = NULL;
+    uint8_t units = APU_UNITS;
+    uint8_t g, u;
+    uint32_t single;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:u:")) != -1) {
+        switch (opt) {
+            case 'c': name = optarg; break;
+            case 'u': units = (uint8_t)atoi(optarg); break;
+            default: name = NULL; units = 0; break;
+        }
+    }
+    if (optind < argc) startDay = (uint16_t)atoi(argv[optind]);
+    if (optind + 1 < argc) days = (uint16_t)atoi(argv[optind + 1]);
+
+    planetGraph(&graph[GRAPH_PLANET]);
+    sunGraph(&graph[GRAPH_SUN]);
+    keplerGraph(&graph[GRAPH_KEPLER]);
+
+    for (g = 0; name != NULL && g < GRAPHS && strcmp(name, graphNames[g]) != 0; ++g)
+        ;
+    if (optind + 2 < argc || days == 0 || units == 0 || units > APU_UNITS || (name != NULL && g == GRAPHS)) {
+        fprintf(stderr, "usage: %s [start_day] [days]\n", argv[0]);
+        fprintf(stderr, "       %s -c planet|sun|kepler [-u units]\n", argv[0]);
+        return 1;
+    }
+
+    if (name != NULL) {
+        if (!schedBuild(&sched, &graph[g], units))
+            return 1;
+        schedWriteC(stdout, &sched, functionNames[g]);
+        return 0;
+    }
+
+    printf("%u days from day %u, Z80 at %.4f MHz, APUs at %.4f MHz\n\n", days, startDay, APU_Z80_CLOCK / 1.0e6, APU_CLOCK / 1.0e6);
+    printf("%-8s %5s %6s %5s %10s %10s %8s %8s %10s %10s\n", "graph", "units", "calls", "pops", "predicted", "emulated", "ms", "speedup", "error", "error fns");
+
+    for (g = 0; g < GRAPHS; ++g) {
+        single = schedBuild(&sched, &graph[g], 1) ? sched.latency : 0;
+        for (u = 1; u <= APU_UNITS; ++u)
+            report(g, u, single);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_simd.h"
+
+// scalar kernels, the existing path, with or without PLANET_MOTION_DEGREES
+
+static void sincosd_scalar ( FLOAT * s, FLOAT * c, const FLOAT * x, uint16_t n )
+{
+    uint16_t k;
+
+    for (k = 0; k < n; ++k) {
+        SINCOSD(x[k], &s[k], &c[k]);
+    }
+}
+
+static void atan2d_scalar ( FLOAT * a, const FLOAT * y, const FLOAT * x, uint16_t n )
+{
+    uint16_t k;
+
+    for (k = 0; k < n; ++k) {
+        a[k] = ATAN2D(y[k], x[k]);
+    }
+}
+
+static uint32_t kepler_scalar ( FLOAT * E, const FLOAT * e, const FLOAT * M, uint16_t n )
+{
+    uint32_t iterations = 0;
+    uint16_t k;
+
+#ifdef PLANET_MOTION_COUNT
+    iterations = eccentricAnomalyIterations;
+#endif
+    for (k = 0; k < n; ++k) {
+        E[k] = eccentricAnomaly(e[k], M[k]);
+    }
+#ifdef PLANET_MOTION_COUNT
+    iterations = eccentricAnomalyIterations - iterations;
+#endif
+    return iterations;
+}
+
+const simd_kernels_t simdScalar = { "scalar", 1, sincosd_scalar, atan2d_scalar, kepler_scalar };
+
+// kernel selection
+
+static const simd_kernels_t * selected;
+
+static uint8_t simdSupported (const simd_kernels_t * kernels)
+{
+#if defined(__x86_64__)
+    if (kernels == &simdAVX2) {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    }
+#endif
+    return kernels != NULL;                                         // scalar and SSE2 always run
+}
+
+uint8_t simdSelect ( const simd_kernels_t * kernels )
+{
+    if (!simdSupported(kernels))
+        return 0;
+
+    selected = kernels;
+    return 1;
+}
+
+const simd_kernels_t * simdKernels ( void )
+{
+    if (selected == NULL) {
+        const simd_kernels_t * const available[] = {
+#if defined(__x86_64__)
+            &simdAVX2, &simdSSE2,
+#endif
+            &simdScalar };
+        const char * name = getenv("PLANET_MOTION_SIMD");
+        uint8_t k;
+
+        for (k = 0; k < sizeof(available)/sizeof(available[0]); ++k) {
+            if (name != NULL && strcmp(name, available[k]->name) != 0)
+                continue;
+            if (simdSelect(available[k]))
+                break;
+        }
+        if (selected == NULL)                                       // unknown or unsupported name
+            selected = &simdScalar;
+    }
+    return selected;
+}
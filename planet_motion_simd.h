@@ -0,0 +1,74 @@
+/*
+ * planet_motion_simd.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_SIMD_H
+#define _PLANET_MOTION_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Array kernels for the batch functions, all angles in degrees.
+//
+// The scalar kernels use the existing SINCOSD(), ATAN2D() and eccentricAnomaly() path.
+// The vector kernels (SSE2 4 lanes, AVX2 8 lanes) use polynomial sincos and atan2, accurate to
+// a few FLOAT ulp, and a lane parallel Newton solver iterated until every lane converges to
+// KEPLER_TOLERANCE. The batch positions from either stay within 1.0e-6 of the orbit radius
+// (3.0e-5 AU for Neptune) of the scalar planetEclipticCartesianCoordinates() path.
+
+// type definitions
+
+typedef struct simd_kernels_s {
+    const char * name;
+    uint8_t lanes;
+
+    void (* sincosd)( FLOAT * s, FLOAT * c, const FLOAT * x, uint16_t n );          // s = sin(x), c = cos(x)
+    void (* atan2d)( FLOAT * a, const FLOAT * y, const FLOAT * x, uint16_t n );     // a = atan2(y,x)
+    uint32_t (* kepler)( FLOAT * E, const FLOAT * e, const FLOAT * M, uint16_t n ); // E = eccentric anomaly, returns lane iterations
+} simd_kernels_t;
+
+extern const simd_kernels_t simdScalar;
+
+#if defined(__x86_64__)
+extern const simd_kernels_t simdSSE2;
+extern const simd_kernels_t simdAVX2;
+#endif
+
+// kernel selection (C)
+
+// The best kernels for this CPU, or those named by the PLANET_MOTION_SIMD environment variable.
+const simd_kernels_t * simdKernels ( void );
+
+// Override the selection, e.g. to compare kernels. Returns 0 if the CPU can't run them.
+uint8_t simdSelect ( const simd_kernels_t * kernels );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_SIMD_H  */
@@ -0,0 +1,19 @@
+
+#include <stdint.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_simd.h"
+
+// AVX2 kernels, 8 lanes.
+
+#if defined(__x86_64__)
+
+#define VECTOR_BYTES    32
+#define KERNEL(name)    name##_avx2
+
+#include "planet_motion_simd_kernels.h"
+
+const simd_kernels_t simdAVX2 = { "avx2", LANES, sincosd_avx2, atan2d_avx2, kepler_avx2 };
+
+#endif
@@ -0,0 +1,169 @@
+
+// Vector kernel template, included by planet_motion_simd_sse2.c and planet_motion_simd_avx2.c
+// with VECTOR_BYTES and KERNEL(name) defined for the instruction set they are compiled for.
+//
+// Written with the gcc / clang vector extensions, so the same source becomes SSE2 or AVX2 code.
+
+#include <string.h>
+
+#define LANES       (VECTOR_BYTES/sizeof(float))
+
+typedef float       vfloat  __attribute__((vector_size(VECTOR_BYTES)));
+typedef int32_t     vint    __attribute__((vector_size(VECTOR_BYTES)));
+typedef uint32_t    vuint   __attribute__((vector_size(VECTOR_BYTES)));
+
+_Static_assert(sizeof(FLOAT) == sizeof(float), "the vector kernels need a float FLOAT");
+
+#define SIGN_BIT    0x80000000
+
+#define RAD_F       ((float)(M_PI/180.0))
+#define DEG_F       ((float)(180.0/M_PI))
+
+static inline vfloat vload (const FLOAT * p)
+{
+    vfloat v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void vstore (FLOAT * p, vfloat v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+// load n < LANES values, padding the vector with zero
+static inline vfloat vloadTail (const FLOAT * p, uint16_t n)
+{
+    vfloat v = { 0 };
+    memcpy(&v, p, n * sizeof(FLOAT));
+    return v;
+}
+
+static inline void vstoreTail (FLOAT * p, vfloat v, uint16_t n)
+{
+    memcpy(p, &v, n * sizeof(FLOAT));
+}
+
+// mask ? a : b, for masks that are all ones or all zeros in each lane
+static inline vfloat vselect (vint mask, vfloat a, vfloat b)
+{
+    return (vfloat)((mask & (vint)a) | (~mask & (vint)b));
+}
+
+static inline vfloat vabs (vfloat x)
+{
+    return (vfloat)((vuint)x & ~SIGN_BIT);
+}
+
+static inline uint8_t vany (vint mask)
+{
+    int32_t any = 0;
+    uint8_t lane;
+
+    for (lane = 0; lane < LANES; ++lane)
+        any |= mask[lane];
+    return any != 0;
+}
+
+// sin and cos of x degrees, reduced to r in [-45,45] degrees by the nearest quadrant q,
+// then the Cephes sinf / cosf minimax polynomials on [-pi/4,pi/4].
+// The bias keeps the conversion of x/90 rounding to nearest, for x > -368640 degrees.
+static inline void vsincosd (vfloat * s, vfloat * c, vfloat x)
+{
+    vint q = __builtin_convertvector(x * (1.0f/90.0f) + 4096.5f, vint) - 4096;
+    vfloat r = (x - __builtin_convertvector(q, vfloat) * 90.0f) * RAD_F;
+    vfloat z = r * r;
+
+    vfloat sp = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+    vfloat cp = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+
+    vint swap = -(q & 1);                                           // odd quadrants swap sin and cos
+    vuint sinSign = (vuint)(q & 2) << 30;                           // quadrants 2,3 negate sin
+    vuint cosSign = (vuint)((q + 1) & 2) << 30;                     // quadrants 1,2 negate cos
+
+    *s = (vfloat)((vuint)vselect(swap, cp, sp) ^ sinSign);
+    *c = (vfloat)((vuint)vselect(swap, sp, cp) ^ cosSign);
+}
+
+// atan2(y,x) in degrees, from the Abramowitz & Stegun 4.4.49 polynomial for atan on [0,1] (error 2e-8 radians)
+static inline vfloat vatan2d (vfloat y, vfloat x)
+{
+    vfloat ax = vabs(x);
+    vfloat ay = vabs(y);
+    vint swap = ay > ax;
+
+    vfloat t = vselect(swap, ax, ay) / (vselect(swap, ay, ax) + 1.0e-30f);
+    vfloat t2 = t * t;
+    vfloat a = (((((((-0.0040540580f * t2 + 0.0218612288f) * t2 - 0.0559098861f) * t2 + 0.0964200441f) * t2
+                - 0.1390853351f) * t2 + 0.1994653599f) * t2 - 0.3332985605f) * t2 + 0.9999993329f) * t * DEG_F;
+
+    a = vselect(swap, 90.0f - a, a);
+    a = vselect(x < 0.0f, 180.0f - a, a);
+    return (vfloat)((vuint)a ^ ((vuint)y & SIGN_BIT));
+}
+
+// Newton iteration for E - DEG(e*sin(E)) = M in degrees, from Schlyter's second order starter,
+// repeated for all lanes until every lane has converged.
+static inline vfloat vkepler (vfloat e, vfloat M, uint8_t * iterations)
+{
+    vfloat E, error, s, c;
+    uint8_t i = 0;
+
+    vsincosd(&s, &c, M);
+    E = M + DEG_F * e * s * (1.0f + e * c);
+
+    do {
+        vsincosd(&s, &c, E);
+        error = (E - DEG_F * e * s - M) / (1.0f - e * c);
+        E -= error;
+    } while (++i < KEPLER_ITERATIONS_MAX && vany(vabs(error) >= (float)KEPLER_TOLERANCE));
+
+    *iterations = i;
+    return E;
+}
+
+static void KERNEL(sincosd) ( FLOAT * s, FLOAT * c, const FLOAT * x, uint16_t n )
+{
+    vfloat vs, vc;
+    uint16_t k;
+
+    for (k = 0; k + LANES <= n; k += LANES) {
+        vsincosd(&vs, &vc, vload(x + k));
+        vstore(s + k, vs);
+        vstore(c + k, vc);
+    }
+    if (k < n) {
+        vsincosd(&vs, &vc, vloadTail(x + k, n - k));
+        vstoreTail(s + k, vs, n - k);
+        vstoreTail(c + k, vc, n - k);
+    }
+}
+
+static void KERNEL(atan2d) ( FLOAT * a, const FLOAT * y, const FLOAT * x, uint16_t n )
+{
+    uint16_t k;
+
+    for (k = 0; k + LANES <= n; k += LANES) {
+        vstore(a + k, vatan2d(vload(y + k), vload(x + k)));
+    }
+    if (k < n) {
+        vstoreTail(a + k, vatan2d(vloadTail(y + k, n - k), vloadTail(x + k, n - k)), n - k);
+    }
+}
+
+static uint32_t KERNEL(kepler) ( FLOAT * E, const FLOAT * e, const FLOAT * M, uint16_t n )
+{
+    uint32_t iterations = 0;
+    uint8_t i;
+    uint16_t k;
+
+    for (k = 0; k + LANES <= n; k += LANES) {
+        vstore(E + k, vkepler(vload(e + k), vload(M + k), &i));
+        iterations += i * LANES;
+    }
+    if (k < n) {
+        vstoreTail(E + k, vkepler(vloadTail(e + k, n - k), vloadTail(M + k, n - k), &i), n - k);
+        iterations += i * (n - k);
+    }
+    return iterations;
+}
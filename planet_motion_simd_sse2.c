@@ -0,0 +1,19 @@
+
+#include <stdint.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_simd.h"
+
+// SSE2 kernels, 4 lanes.
+
+#if defined(__x86_64__)
+
+#define VECTOR_BYTES    16
+#define KERNEL(name)    name##_sse2
+
+#include "planet_motion_simd_kernels.h"
+
+const simd_kernels_t simdSSE2 = { "sse2", LANES, sincosd_sse2, atan2d_sse2, kepler_sse2 };
+
+#endif
@@ -0,0 +1,65 @@
+
+#include <stdint.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+#include "planet_motion_sky.h"
+
+// The Sun is computed once for the day, and shared by every body as the Earth's position.
+// sun and moon orbit the Earth, so their geocentric position is their orbit position, and
+// the heliocentric position is found from it, rather than the other way round.
+
+void skyInit ( sky_t * sky, const planet_t * const * planet, uint8_t bodies, FLOAT day, FLOAT step )
+{
+    uint8_t b;
+
+    if (bodies > SKY_BODIES_MAX)
+        bodies = SKY_BODIES_MAX;
+
+    sky->bodies = bodies;
+    sky->planet = planet;
+
+    sunStepperInit(&sky->sunStepper, day, step, STEPPER_RENORMALISE);
+    for (b = 0; b < bodies; ++b)
+        planetStepperInit(&sky->stepper[b], planet[b], day, step, STEPPER_RENORMALISE);
+}
+
+void skyCoordinates ( sky_t * sky, FLOAT day ) __z88dk_callee
+{
+    cartesian_coordinates_t * helio = sky->helio;
+    cartesian_coordinates_t * geo = sky->geo;
+    FLOAT sunX, sunY, sunZ;
+    uint8_t b;
+
+    sky->sun.day = day;
+    sunStepperEclipticCartesianCoordinates(&sky->sun, &sky->sunStepper);
+
+    sunX = sky->sun.x;
+    sunY = sky->sun.y;
+    sunZ = sky->sun.z;
+
+    for (b = 0; b < sky->bodies; ++b, ++helio, ++geo) {
+        const planet_t * planet = sky->planet[b];
+
+        if (planet == &sun || planet == &moon) {                    // orbits the Earth
+            geo->day = day;
+            planetStepperEclipticCartesianCoordinates(geo, &sky->stepper[b]);
+
+            helio->x = geo->x - sunX;
+            helio->y = geo->y - sunY;
+            helio->z = geo->z - sunZ;
+            helio->au = geo->au;
+            helio->day = day;
+        } else {
+            helio->day = day;
+            planetStepperEclipticCartesianCoordinates(helio, &sky->stepper[b]);
+
+            geo->x = helio->x + sunX;
+            geo->y = helio->y + sunY;
+            geo->z = helio->z + sunZ;
+            geo->au = helio->au;
+            geo->day = day;
+        }
+    }
+}
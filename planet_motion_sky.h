@@ -0,0 +1,65 @@
+/*
+ * planet_motion_sky.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_SKY_H
+#define _PLANET_MOTION_SKY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// most bodies in a sky
+
+#define SKY_BODIES_MAX  PLANETS
+
+// type definitions
+
+typedef struct sky_s {              // the Sun and a set of bodies, for one day at a time
+    uint8_t bodies;
+    const planet_t * const * planet;    // the bodies, where sun and moon orbit the Earth.
+    sun_stepper_t sunStepper;
+    planet_stepper_t stepper[SKY_BODIES_MAX];
+    cartesian_coordinates_t sun;    // the Sun seen from Earth, with the Earth's orbit radius.
+    cartesian_coordinates_t helio[SKY_BODIES_MAX];  // heliocentric, with the orbit radius about the Sun, or the Earth for sun and moon.
+    cartesian_coordinates_t geo[SKY_BODIES_MAX];    // geocentric, with the same orbit radius.
+} sky_t;
+
+// sky functions (C), also provided by planet_motion_fixed.c and planet_motion_mapu.c for their builds,
+// where every body is computed directly each day rather than stepped
+
+// Prepare a sky of bodies, to be stepped by step days from day.
+void skyInit ( sky_t * sky, const planet_t * const * planet, uint8_t bodies, FLOAT day, FLOAT step );
+
+// The Sun and every body for day, one step on from the last day by the steppers, or evaluated directly.
+void skyCoordinates ( sky_t * sky, FLOAT day ) __z88dk_callee;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_SKY_H  */
@@ -0,0 +1,83 @@
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_kepler.h"
+#include "planet_motion_state.h"
+
+// The node N and inclination i drift by 1e-5 to 1e-9 deg/day (except for the Moon), and the
+// eccentricity e by less than 1e-8 per day, so their trigonometry and sqrt(1-e*e) are cached
+// and only recomputed once the drift since the cache day could exceed the tolerance.
+
+void planetStateInit ( planet_state_t * state, const planet_t * planet, FLOAT tolerance )
+{
+    FLOAT rate, rateE;
+
+    state->planet = planet;
+    state->tolerance = tolerance;
+    state->valid = 0;
+    state->solver = NULL;
+
+    rate = FABS(planet->Nc);
+    if (FABS(planet->ic) > rate)
+        rate = FABS(planet->ic);
+
+    rateE = DEG(planet->e0 * FABS(planet->ec) / (1.0 - SQR(planet->e0)));  // relative drift of sqrt(1-e*e), as an angle
+    if (rateE > rate)
+        rate = rateE;
+
+    state->window = (rate > 0.0) ? (tolerance / rate) : 1.0e30;
+}
+
+static void planetStateRefresh ( planet_state_t * state, FLOAT day )
+{
+    const planet_t * planet = state->planet;
+
+    FLOAT N = rev( planet->N0 + (day * planet->Nc) );
+    FLOAT i = rev( planet->i0 + (day * planet->ic) );
+    FLOAT e = planet->e0 + (day * planet->ec);
+
+    SINCOSD(N, &state->sinN, &state->cosN);
+    SINCOSD(i, &state->sini, &state->cosi);
+    state->sqrte = SQRT(1.0 - SQR(e));
+
+    state->day = day;
+    state->valid = 1;
+}
+
+void planetStateEclipticCartesianCoordinates ( cartesian_coordinates_t * location, planet_state_t * state ) __z88dk_callee
+{
+    const planet_t * planet = state->planet;
+    FLOAT day = location->day;
+    FLOAT w, a, e, M, E, sinE, cosE, xv, yv, v, r, cosVW, sinVW;
+
+    if (!state->valid || FABS(day - state->day) > state->window)
+        planetStateRefresh(state, day);
+
+    w = rev( planet->w0 + (day * planet->wc) );
+    a = planet->a0 + (day * planet->ac);
+    e = planet->e0 + (day * planet->ec);
+    M = rev( planet->M0 + (day * planet->Mc) );
+
+    E = rev(state->solver ? keplerSolve (state->solver, e, M) : eccentricAnomaly (e, M));
+
+    // Calculate the body's position in its own orbital plane, and its distance from the thing it is orbiting.
+    SINCOSD(E, &sinE, &cosE);
+    xv = a * (cosE - e);
+    yv = a * state->sqrte * sinE;
+
+    v = ATAN2D(yv, xv);                 // True anomaly in degrees: the angle from perihelion of the body as seen by the Sun.
+    r = HYPOT(xv, yv);                  // Distance from the Sun to the planet in AU
+
+    SINCOSD(v+w, &sinVW, &cosVW);
+
+    // Now we are ready to calculate (unperturbed) ecliptic cartesian heliocentric coordinates.
+    location->x = r * (state->cosN*cosVW - state->sinN*sinVW*state->cosi);
+    location->y = r * (state->sinN*cosVW + state->cosN*sinVW*state->cosi);
+    location->z = r * sinVW * state->sini;
+
+    // save the radius from the sun in AU
+    location->au = r;
+}
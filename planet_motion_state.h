@@ -0,0 +1,66 @@
+/*
+ * planet_motion_state.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_STATE_H
+#define _PLANET_MOTION_STATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// default drift allowed in the cached quantities, in degrees (0.001 degrees is 0.025 pixels for Neptune)
+
+#define PLANET_STATE_TOLERANCE  1.0e-3
+
+// type definitions
+
+typedef struct planet_state_s {     // derived orbital elements of a planet_t, valid over a window of days
+    const planet_t * planet;
+    FLOAT tolerance;        // drift allowed in the cached quantities (deg).
+    FLOAT window;           // the cache is valid for days within window of day.
+    FLOAT day;              // day the cache was computed for.
+    uint8_t valid;          // the cache has been computed.
+    FLOAT cosN, sinN;       // longitude of the ascending node.
+    FLOAT cosi, sini;       // inclination to the ecliptic.
+    FLOAT sqrte;            // sqrt(1 - e*e), the ratio of minor to major axis.
+    struct kepler_solver_s * solver;    // Kepler solver for this planet, or NULL for eccentricAnomaly().
+} planet_state_t;
+
+// planet state functions (C)
+
+// Prepare a state for planet, with the cache computed lazily on first use, solving with eccentricAnomaly().
+void planetStateInit ( planet_state_t * state, const planet_t * planet, FLOAT tolerance );
+
+// As planetEclipticCartesianCoordinates(), refreshing the cache when location->day is outside its window.
+void planetStateEclipticCartesianCoordinates ( cartesian_coordinates_t * location, planet_state_t * state ) __z88dk_callee;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_STATE_H  */
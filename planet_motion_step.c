@@ -0,0 +1,255 @@
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_step.h"
+
+// The steppers advance each angle by its fixed rate per step, rotating its sine and cosine
+// by the angle sum identities, so that a step needs no trigonometry at all.
+// Every renormalise steps the state is evaluated directly again, to bound the drift.
+//
+// The node, inclination and perihelion of the planets move by as little as 1e-7 degrees per day,
+// which is lost in rotating a FLOAT sine and cosine, so these are rotated from their values at the
+// last direct evaluation by the whole angle moved since then. For the same reason M is stepped
+// from its value at the last direct evaluation, rather than accumulated.
+//
+// Kepler's equation is warm started from the previous eccentric anomaly, predicting the change
+// in E from the change in M, and the Newton corrections rotate sin(E) and cos(E) by small angles.
+
+#define SMALL_ANGLE     30.0                // degrees, the largest rotation by polynomial
+
+// sin and cos of a small angle x in degrees, by Taylor series (error < 1e-8 for |x| <= 30)
+static void sincosSmall (FLOAT x, FLOAT * s, FLOAT * c)
+{
+    FLOAT r = RAD(x);
+    FLOAT r2 = r * r;
+
+    *s = r * (1.0 - r2 * (1.0/6.0) * (1.0 - r2 * (1.0/20.0) * (1.0 - r2 * (1.0/42.0))));
+    *c = 1.0 - r2 * 0.5 * (1.0 - r2 * (1.0/12.0) * (1.0 - r2 * (1.0/30.0) * (1.0 - r2 * (1.0/56.0))));
+}
+
+// rotate the angle with sine s and cosine c by the angle with sine sd and cosine cd,
+// and pull the result back onto the unit circle
+static void rotate (FLOAT * s, FLOAT * c, FLOAT sd, FLOAT cd)
+{
+    FLOAT sn = *s * cd + *c * sd;
+    FLOAT cn = *c * cd - *s * sd;
+    FLOAT k = (3.0 - (sn * sn + cn * cn)) * 0.5;
+
+    *s = sn * k;
+    *c = cn * k;
+}
+
+// the sine s and cosine c of the angle with sine s0 and cosine c0, rotated by x degrees
+static void rotateFrom (FLOAT * s, FLOAT * c, FLOAT s0, FLOAT c0, FLOAT x)
+{
+    FLOAT sd, cd;
+
+    sincosSmall(x, &sd, &cd);
+    *s = s0 * cd + c0 * sd;
+    *c = c0 * cd - s0 * sd;
+}
+
+// rotate E by delta degrees, as rounded into E, so that sin(E) and cos(E) stay in step with E
+static void rotateE (planet_stepper_t * stepper, FLOAT delta)
+{
+    FLOAT E = stepper->E + delta;
+    FLOAT sd, cd;
+
+    delta = E - stepper->E;
+    stepper->E = E;
+    if (FABS(delta) > SMALL_ANGLE) {
+        SINCOSD(stepper->E, &stepper->sinE, &stepper->cosE);
+    } else {
+        sincosSmall(delta, &sd, &cd);
+        rotate(&stepper->sinE, &stepper->cosE, sd, cd);
+    }
+}
+
+static void planetStepperDirect (planet_stepper_t * stepper, FLOAT day)
+{
+    const planet_t * planet = stepper->planet;
+
+    FLOAT N = rev( planet->N0 + (day * planet->Nc) );
+    FLOAT i = rev( planet->i0 + (day * planet->ic) );
+    FLOAT w = rev( planet->w0 + (day * planet->wc) );
+
+    stepper->a = planet->a0 + (day * planet->ac);
+    stepper->e = planet->e0 + (day * planet->ec);
+    stepper->sqrte = SQRT(1.0 - SQR(stepper->e));
+    stepper->M0 = stepper->M = rev( planet->M0 + (day * planet->Mc) );
+    stepper->E = eccentricAnomaly (stepper->e, stepper->M);
+
+    SINCOSD(N, &stepper->sinN0, &stepper->cosN0);
+    SINCOSD(i, &stepper->sini0, &stepper->cosi0);
+    SINCOSD(w, &stepper->sinw0, &stepper->cosw0);
+    SINCOSD(stepper->E, &stepper->sinE, &stepper->cosE);
+
+    stepper->sinN = stepper->sinN0;
+    stepper->cosN = stepper->cosN0;
+    stepper->sini = stepper->sini0;
+    stepper->cosi = stepper->cosi0;
+    stepper->sinw = stepper->sinw0;
+    stepper->cosw = stepper->cosw0;
+
+    stepper->day = day;
+    stepper->steps = 0;
+}
+
+static void planetStepperAdvance (planet_stepper_t * stepper)
+{
+    const planet_t * planet = stepper->planet;
+    FLOAT steps = stepper->steps + 1;
+    FLOAT delta;
+
+    rotateFrom(&stepper->sinN, &stepper->cosN, stepper->sinN0, stepper->cosN0, stepper->dN * steps);
+    rotateFrom(&stepper->sini, &stepper->cosi, stepper->sini0, stepper->cosi0, stepper->di * steps);
+    rotateFrom(&stepper->sinw, &stepper->cosw, stepper->sinw0, stepper->cosw0, stepper->dw * steps);
+
+    stepper->day += stepper->step;
+    stepper->a = planet->a0 + (stepper->day * planet->ac);
+    stepper->e = planet->e0 + (stepper->day * planet->ec);
+
+    stepper->M = stepper->M0 + stepper->dM * steps;                 // M and E run on past 360 until the next direct evaluation
+
+    delta = stepper->dM / (1.0 - stepper->e * stepper->cosE);       // predicted change in E
+    stepper->iterations = 0;
+
+    do {
+        COUNT_ITERATION();
+        ++stepper->iterations;
+        rotateE(stepper, delta);
+        delta = (stepper->M - stepper->E + DEG(stepper->e * stepper->sinE)) / (1.0 - stepper->e * stepper->cosE);
+    } while (FABS(delta) >= KEPLER_TOLERANCE && stepper->iterations < KEPLER_ITERATIONS_MAX);
+
+    rotateE(stepper, delta);                                        // the last correction is nearly free
+
+    ++stepper->steps;
+}
+
+void planetStepperInit ( planet_stepper_t * stepper, const planet_t * planet, FLOAT day, FLOAT step, uint16_t renormalise )
+{
+    stepper->planet = planet;
+    stepper->step = step;
+    stepper->iterations = 0;
+    stepper->dM = planet->Mc * step;
+    stepper->dN = planet->Nc * step;
+    stepper->di = planet->ic * step;
+    stepper->dw = planet->wc * step;
+
+    while (renormalise > 1 && (FABS(stepper->dN) > SMALL_ANGLE / renormalise || FABS(stepper->dw) > SMALL_ANGLE / renormalise))
+        renormalise >>= 1;                                          // keep the rotations within the polynomial
+
+    stepper->renormalise = renormalise;
+
+    planetStepperDirect(stepper, day);
+}
+
+void planetStepperEclipticCartesianCoordinates ( cartesian_coordinates_t * location, planet_stepper_t * stepper ) __z88dk_callee
+{
+    PROFILE_BODY(stepper->planet)
+    FLOAT xv, yv, rcosVW, rsinVW;
+
+    if (location->day != stepper->day) {
+        if (location->day == stepper->day + stepper->step && stepper->steps < stepper->renormalise)
+            planetStepperAdvance(stepper);
+        else
+            planetStepperDirect(stepper, location->day);
+    }
+
+    // Calculate the body's position in its own orbital plane, and its distance from the thing it is orbiting.
+    xv = stepper->a * (stepper->cosE - stepper->e);
+    yv = stepper->a * stepper->sqrte * stepper->sinE;
+
+    // The true anomaly v is the angle of (xv, yv), so r*cos(v+w) and r*sin(v+w) follow from the angle sum identities.
+    rcosVW = xv * stepper->cosw - yv * stepper->sinw;
+    rsinVW = yv * stepper->cosw + xv * stepper->sinw;
+
+    // Now we are ready to calculate (unperturbed) ecliptic cartesian heliocentric coordinates.
+    location->x = stepper->cosN*rcosVW - stepper->sinN*rsinVW*stepper->cosi;
+    location->y = stepper->sinN*rcosVW + stepper->cosN*rsinVW*stepper->cosi;
+    location->z = rsinVW * stepper->sini;
+
+    // save the radius from the sun in AU
+    location->au = stepper->a * (1.0 - stepper->e * stepper->cosE);
+    PROFILE_COUNT(PROFILE_POSITIONS);
+}
+
+
+static void sunStepperDirect (sun_stepper_t * stepper, FLOAT day)
+{
+    // As sunEclipticCartesianCoordinates(), with the rates of L0 and M0 at T for the rotations per step.
+    FLOAT T = (day - 1.5) * 0.0000273785;                           // 36525.0 Julian centuries since J2000.0
+    FLOAT dT = stepper->step * 0.0000273785;
+
+    FLOAT T_SQR = SQR(T);
+
+    FLOAT L0 = rev(280.46645 + (36000.76983 * T) + (0.0003032 * T_SQR));                            // Sun's mean longitude, in degrees
+    FLOAT M0 = rev(357.52910 + (35999.05030 * T) - (0.0001559 * T_SQR) - (0.00000048 * T * T_SQR));     // Sun's mean anomaly, in degrees
+
+    SINCOSD(L0, &stepper->sinL, &stepper->cosL);
+    SINCOSD(M0, &stepper->sinM, &stepper->cosM);
+    SINCOSD((36000.76983 + 0.0006064 * T) * dT, &stepper->sindL, &stepper->cosdL);
+    SINCOSD((35999.05030 - 0.0003118 * T - 0.00000144 * T_SQR) * dT, &stepper->sindM, &stepper->cosdM);
+
+    stepper->c1 = 1.914600 - 0.004817 * T - 0.000014 * T_SQR;
+    stepper->c2 = 0.01993 - 0.000101 * T;
+    stepper->c3 = 0.000290;
+
+    stepper->e = 0.016708617 - T * (0.000042037 + T * 0.0000001236);   // The eccentricity of the Earth's orbit.
+    stepper->de = -(0.000042037 + 2.0 * T * 0.0000001236) * dT;
+
+    stepper->day = day;
+    stepper->steps = 0;
+}
+
+static void sunStepperAdvance (sun_stepper_t * stepper)
+{
+    rotate(&stepper->sinL, &stepper->cosL, stepper->sindL, stepper->cosdL);
+    rotate(&stepper->sinM, &stepper->cosM, stepper->sindM, stepper->cosdM);
+    stepper->e += stepper->de;
+
+    stepper->day += stepper->step;
+    ++stepper->steps;
+}
+
+void sunStepperInit ( sun_stepper_t * stepper, FLOAT day, FLOAT step, uint16_t renormalise )
+{
+    stepper->step = step;
+    stepper->renormalise = renormalise;
+
+    sunStepperDirect(stepper, day);
+}
+
+void sunStepperEclipticCartesianCoordinates ( cartesian_coordinates_t * sun, sun_stepper_t * stepper ) __z88dk_callee
+{
+    PROFILE_BODY(NULL)
+    FLOAT sinM, cosM, C, sinC, cosC, distanceInAU;
+
+    if (sun->day != stepper->day) {
+        if (sun->day == stepper->day + stepper->step && stepper->steps < stepper->renormalise)
+            sunStepperAdvance(stepper);
+        else
+            sunStepperDirect(stepper, sun->day);
+    }
+
+    sinM = stepper->sinM;
+    cosM = stepper->cosM;
+
+    // Sun's equation of center in degrees, with sin(2*M0) and sin(3*M0) from sin(M0) and cos(M0)
+    C = stepper->c1 * sinM + stepper->c2 * 2.0 * sinM * cosM + stepper->c3 * sinM * (3.0 - 4.0 * SQR(sinM));
+    sincosSmall(C, &sinC, &cosC);
+
+    // distance from Sun to Earth in astronomical units (AU), with cos(M0 + C)
+    distanceInAU = (1.000001018 * (1 - SQR(stepper->e))) / (1 + stepper->e * (cosM * cosC - sinM * sinC));
+
+    // true ecliptical longitude of Sun, L0 + C
+    sun->x = distanceInAU * (stepper->cosL * cosC - stepper->sinL * sinC);
+    sun->y = distanceInAU * (stepper->sinL * cosC + stepper->cosL * sinC);
+    sun->z = 0.0;                                                   // the Earth's center is always on the plane of the ecliptic (z=0), by definition!
+
+    sun->au = distanceInAU;
+    PROFILE_COUNT(PROFILE_POSITIONS);
+}
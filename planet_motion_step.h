@@ -0,0 +1,92 @@
+/*
+ * planet_motion_step.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_STEP_H
+#define _PLANET_MOTION_STEP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Steps between direct evaluations, which re-normalise the angle recurrences.
+
+#define STEPPER_RENORMALISE     32
+
+// type definitions
+
+typedef struct planet_stepper_s {   // a planet_t advanced by a fixed step in days
+    const planet_t * planet;
+    FLOAT day;              // day of the current state.
+    FLOAT step;             // days per step.
+    uint16_t steps;         // steps taken since the last direct evaluation.
+    uint16_t renormalise;   // steps between direct evaluations.
+    uint8_t iterations;     // Newton iterations of the last step.
+    FLOAT dM;               // mean anomaly change per step (deg).
+    FLOAT dN, di, dw;       // change of N, i and w per step (deg).
+    FLOAT a, e, sqrte;      // semi-major axis, eccentricity and sqrt(1-e*e).
+    FLOAT M0;               // mean anomaly at the last direct evaluation (deg).
+    FLOAT M, E;             // mean and eccentric anomaly (deg), with E tracking M.
+    FLOAT cosN0, sinN0;     // N, i and w at the last direct evaluation.
+    FLOAT cosi0, sini0;
+    FLOAT cosw0, sinw0;
+    FLOAT cosN, sinN;
+    FLOAT cosi, sini;
+    FLOAT cosw, sinw;
+    FLOAT cosE, sinE;
+} planet_stepper_t;
+
+typedef struct sun_stepper_s {      // the Sun, as seen from Earth, advanced by a fixed step in days
+    FLOAT day;              // day of the current state.
+    FLOAT step;             // days per step.
+    uint16_t steps;         // steps taken since the last direct evaluation.
+    uint16_t renormalise;   // steps between direct evaluations.
+    FLOAT cosdL, sindL;     // rotation of L0 and M0 per step.
+    FLOAT cosdM, sindM;
+    FLOAT cosL, sinL;       // Sun's mean longitude L0.
+    FLOAT cosM, sinM;       // Sun's mean anomaly M0.
+    FLOAT c1, c2, c3;       // equation of center coefficients of sin(M0), sin(2*M0) and sin(3*M0).
+    FLOAT e, de;            // eccentricity of the Earth's orbit, and its change per step.
+} sun_stepper_t;
+
+// stepper functions (C)
+
+// Prepare a stepper, with its state evaluated directly for day.
+void planetStepperInit ( planet_stepper_t * stepper, const planet_t * planet, FLOAT day, FLOAT step, uint16_t renormalise );
+void sunStepperInit ( sun_stepper_t * stepper, FLOAT day, FLOAT step, uint16_t renormalise );
+
+// As planetEclipticCartesianCoordinates() and sunEclipticCartesianCoordinates().
+// When location->day is one step on from the stepper day the state is advanced by the recurrences,
+// any other day is evaluated directly.
+void planetStepperEclipticCartesianCoordinates ( cartesian_coordinates_t * location, planet_stepper_t * stepper ) __z88dk_callee;
+void sunStepperEclipticCartesianCoordinates ( cartesian_coordinates_t * sun, sun_stepper_t * stepper ) __z88dk_callee;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_STEP_H  */
@@ -0,0 +1,202 @@
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_simd.h"
+#include "planet_motion_topo.h"
+
+// The obliquity and the sidereal time are found once an instant, and each observer's zenith, east
+// and north directions once an instant for every body. Each body is then a few multiplications per
+// observer to find its place against those directions, TOPO_BATCH observers at a time, so that
+// the loops run over contiguous arrays the compiler can vectorise, with the angles found by the
+// atan2 kernel chosen by simdKernels().
+//
+// The observer's place is from its geocentric latitude and distance from the centre of the Earth,
+// while the horizon is square to its geodetic latitude.
+
+#define TOPO_ARRAYS         14              // arrays of each observer
+
+#if defined(__MATH_MATH32) || defined(__MATH_AM9511)
+    #define REV(x)  rev(x)
+#else
+    #define REV(x)  ((x) - FLOOR((x)*(FLOAT)(1/360.0))*(FLOAT)360.0)
+#endif
+
+void topoInstant ( topo_instant_t * instant, FLOAT day )
+{
+    FLOAT L = sun.M0 + sun.w0 + (day * (sun.Mc + sun.wc));          // Sun's mean longitude
+
+    instant->day = day;
+    instant->obliquity = 23.4393 - 3.563E-7 * day;
+    SINCOSD(instant->obliquity, &instant->sinObliquity, &instant->cosObliquity);
+    instant->gmst = rev(L + 180.0 + (day - FLOOR(day)) * 360.0);    // GMST0 and the UT of the day
+}
+
+void topoEquatorial ( cartesian_coordinates_t * equatorial, const cartesian_coordinates_t * ecliptic, const topo_instant_t * instant )
+{
+    FLOAT y = ecliptic->y;
+    FLOAT z = ecliptic->z;
+
+    equatorial->x = ecliptic->x;
+    equatorial->y = y * instant->cosObliquity - z * instant->sinObliquity;
+    equatorial->z = y * instant->sinObliquity + z * instant->cosObliquity;
+    equatorial->au = ecliptic->au;
+    equatorial->day = ecliptic->day;
+}
+
+void topoRaDec ( FLOAT * ra, FLOAT * dec, const cartesian_coordinates_t * equatorial )
+{
+    *ra = ATAN2D(equatorial->y, equatorial->x);
+    if (*ra < 0.0)
+        *ra += 360.0;
+    *dec = ATAN2D(equatorial->z, SQRT(SQR(equatorial->x) + SQR(equatorial->y)));
+}
+
+uint8_t topoObserversInit ( topo_observers_t * observers, const FLOAT * latitude, const FLOAT * longitude, uint32_t count )
+{
+    FLOAT * p = malloc((size_t)TOPO_ARRAYS * (count ? count : 1) * sizeof(FLOAT));
+    FLOAT ** array[TOPO_ARRAYS] = { &observers->latitude, &observers->longitude, &observers->sinLat, &observers->cosLat,
+                                    &observers->rhoCos, &observers->rhoSin, &observers->zx, &observers->zy,
+                                    &observers->ex, &observers->ey, &observers->nx, &observers->ny,
+                                    &observers->ox, &observers->oy };
+    uint32_t k;
+
+    if (p == NULL)
+        return 0;
+
+    observers->count = count;
+    for (k = 0; k < TOPO_ARRAYS; ++k)
+        *array[k] = p + (size_t)k * count;
+
+    for (k = 0; k < count; ++k) {
+        FLOAT lat = latitude[k];
+        FLOAT geocentric = lat - 0.1924 * SIND(2 * lat);
+        FLOAT rho = (0.99833 + 0.00167 * COSD(2 * lat)) * (1.0/EARTH_RADII_PER_ASTRONOMICAL_UNIT);
+        FLOAT s, c;
+
+        observers->latitude[k] = lat;
+        observers->longitude[k] = longitude[k];
+        SINCOSD(lat, &observers->sinLat[k], &observers->cosLat[k]);
+        SINCOSD(geocentric, &s, &c);
+        observers->rhoCos[k] = rho * c;
+        observers->rhoSin[k] = rho * s;
+    }
+    return 1;
+}
+
+void topoObserversFree ( topo_observers_t * observers )
+{
+    free(observers->latitude);
+    observers->latitude = NULL;
+    observers->count = 0;
+}
+
+void topoObserversInstant ( topo_observers_t * observers, const topo_instant_t * instant )
+{
+    const simd_kernels_t * kernels = simdKernels();
+    FLOAT lst[TOPO_BATCH], s[TOPO_BATCH], c[TOPO_BATCH];
+    uint32_t start;
+    uint16_t k, n;
+
+    for (start = 0; start < observers->count; start += n) {
+        const FLOAT * longitude = observers->longitude + start;
+        const FLOAT * sinLat = observers->sinLat + start;
+        const FLOAT * cosLat = observers->cosLat + start;
+        const FLOAT * rhoCos = observers->rhoCos + start;
+
+        n = (observers->count - start) < TOPO_BATCH ? (uint16_t)(observers->count - start) : TOPO_BATCH;
+
+        for (k = 0; k < n; ++k) {                                   // local sidereal time
+            lst[k] = instant->gmst + longitude[k];
+            lst[k] = REV(lst[k]);
+        }
+
+        kernels->sincosd(s, c, lst, n);
+
+        for (k = 0; k < n; ++k) {
+            observers->zx[start + k] = cosLat[k] * c[k];
+            observers->zy[start + k] = cosLat[k] * s[k];
+            observers->ex[start + k] = -s[k];
+            observers->ey[start + k] = c[k];
+            observers->nx[start + k] = -sinLat[k] * c[k];
+            observers->ny[start + k] = -sinLat[k] * s[k];
+            observers->ox[start + k] = rhoCos[k] * c[k];
+            observers->oy[start + k] = rhoCos[k] * s[k];
+        }
+    }
+}
+
+void topoHorizontal ( FLOAT * altitude, FLOAT * azimuth, FLOAT * ra, FLOAT * dec, const topo_observers_t * observers, const cartesian_coordinates_t * equatorial, uint8_t bodies )
+{
+    const simd_kernels_t * kernels = simdKernels();
+    FLOAT up[TOPO_BATCH], across[TOPO_BATCH], east[TOPO_BATCH], north[TOPO_BATCH];
+    FLOAT vx[TOPO_BATCH], vy[TOPO_BATCH], vz[TOPO_BATCH], vxy[TOPO_BATCH];
+    uint32_t count = observers->count;
+    uint32_t start;
+    uint16_t k, n;
+    uint8_t b;
+
+    for (start = 0; start < count; start += n) {                    // the observers stay in cache for every body
+        const FLOAT * sinLat = observers->sinLat + start;
+        const FLOAT * cosLat = observers->cosLat + start;
+        const FLOAT * rhoSin = observers->rhoSin + start;
+        const FLOAT * zx = observers->zx + start;
+        const FLOAT * zy = observers->zy + start;
+        const FLOAT * ex = observers->ex + start;
+        const FLOAT * ey = observers->ey + start;
+        const FLOAT * nx = observers->nx + start;
+        const FLOAT * ny = observers->ny + start;
+        const FLOAT * ox = observers->ox + start;
+        const FLOAT * oy = observers->oy + start;
+
+        n = (count - start) < TOPO_BATCH ? (uint16_t)(count - start) : TOPO_BATCH;
+
+        for (b = 0; b < bodies; ++b) {
+            FLOAT x = equatorial[b].x;
+            FLOAT y = equatorial[b].y;
+            FLOAT z = equatorial[b].z;
+            uint32_t row = (uint32_t)b * count + start;
+            FLOAT * az = azimuth + row;
+
+            for (k = 0; k < n; ++k) {                               // from the observer
+                vx[k] = x - ox[k];
+                vy[k] = y - oy[k];
+                vz[k] = z - rhoSin[k];
+            }
+
+            for (k = 0; k < n; ++k) {
+                up[k] = vx[k] * zx[k] + vy[k] * zy[k] + vz[k] * sinLat[k];
+                east[k] = vx[k] * ex[k] + vy[k] * ey[k];
+                north[k] = vx[k] * nx[k] + vy[k] * ny[k] + vz[k] * cosLat[k];
+            }
+
+            for (k = 0; k < n; ++k) {
+                across[k] = SQRT(east[k] * east[k] + north[k] * north[k]);
+            }
+
+            kernels->atan2d(altitude + row, up, across, n);
+            kernels->atan2d(az, east, north, n);
+
+            for (k = 0; k < n; ++k) {
+                az[k] += (az[k] < 0.0) ? (FLOAT)360.0 : (FLOAT)0.0;
+            }
+
+            if (ra != NULL && dec != NULL) {
+                FLOAT * r = ra + row;
+
+                for (k = 0; k < n; ++k) {
+                    vxy[k] = SQRT(vx[k] * vx[k] + vy[k] * vy[k]);
+                }
+
+                kernels->atan2d(r, vy, vx, n);
+                kernels->atan2d(dec + row, vz, vxy, n);
+
+                for (k = 0; k < n; ++k) {
+                    r[k] += (r[k] < 0.0) ? (FLOAT)360.0 : (FLOAT)0.0;
+                }
+            }
+        }
+    }
+}
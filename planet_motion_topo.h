@@ -0,0 +1,87 @@
+/*
+ * planet_motion_topo.h
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef _PLANET_MOTION_TOPO_H
+#define _PLANET_MOTION_TOPO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host transformation of geocentric ecliptic positions to the equator, and to the horizon of many
+// observers at once, each as seen from its place on the Earth. No refraction is applied.
+
+#define TOPO_BATCH          256             // observers through each stage at a time
+
+// type definitions
+
+typedef struct topo_instant_s {     // quantities shared by every body and observer at an instant
+    FLOAT day;
+    FLOAT obliquity;        // of the ecliptic (deg).
+    FLOAT cosObliquity, sinObliquity;
+    FLOAT gmst;             // Greenwich mean sidereal time (deg).
+} topo_instant_t;
+
+typedef struct topo_observers_s {   // observers on the Earth, as arrays of each quantity
+    uint32_t count;
+    FLOAT * latitude;       // geodetic latitude (deg), north positive.
+    FLOAT * longitude;      // (deg), east positive.
+    FLOAT * sinLat, * cosLat;
+    FLOAT * rhoCos, * rhoSin;   // the observer from the centre of the Earth (AU), across and along the axis.
+    FLOAT * zx, * zy;       // the zenith, east and north of each observer at the instant, in equatorial
+    FLOAT * ex, * ey;       // coordinates, where the z components are sinLat, 0 and cosLat.
+    FLOAT * nx, * ny;
+    FLOAT * ox, * oy;       // the observer at the instant (AU), where oz is rhoSin.
+} topo_observers_t;
+
+// topocentric functions (C)
+
+// The obliquity and sidereal time of day, as in http://www.stjarnhimlen.se/comp/ppcomp.html#5
+void topoInstant ( topo_instant_t * instant, FLOAT day );
+
+// A geocentric ecliptic position rotated into equatorial coordinates, and its right ascension [0, 360) and declination (deg).
+void topoEquatorial ( cartesian_coordinates_t * equatorial, const cartesian_coordinates_t * ecliptic, const topo_instant_t * instant );
+void topoRaDec ( FLOAT * ra, FLOAT * dec, const cartesian_coordinates_t * equatorial );
+
+// Observers at count latitudes and longitudes (deg), which are copied. Returns 0 if out of memory.
+uint8_t topoObserversInit ( topo_observers_t * observers, const FLOAT * latitude, const FLOAT * longitude, uint32_t count );
+void topoObserversFree ( topo_observers_t * observers );
+
+// Turn the observers to the sidereal time of instant, once for every body.
+void topoObserversInstant ( topo_observers_t * observers, const topo_instant_t * instant );
+
+// The altitude and azimuth (deg, from north through east) of each of bodies equatorial positions (AU) for each
+// observer, body b of observer k into [b * count + k], with the topocentric right ascension and declination
+// when ra and dec are not NULL. The Moon's distance is in AU, so its parallax of about a degree is included.
+void topoHorizontal ( FLOAT * altitude, FLOAT * azimuth, FLOAT * ra, FLOAT * dec, const topo_observers_t * observers, const cartesian_coordinates_t * equatorial, uint8_t bodies );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _PLANET_MOTION_TOPO_H  */
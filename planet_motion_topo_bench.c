@@ -0,0 +1,234 @@
+/*
+ * planet_motion_topo_bench.c
+ *
+ * Copyright (c) 2021 Phillip Stevens
+ * Create Time: October 2026
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted,free of charge,to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),to deal
+ * in the Software without restriction,including without limitation the rights
+ * to use,copy,modify,merge,publish,distribute,sublicense,and/or sell
+ * copies of the Software,and to permit persons to whom the Software is
+ * furnished to do so,subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS",WITHOUT WARRANTY OF ANY KIND,EXPRESS OR
+ * IMPLIED,INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,DAMAGES OR OTHER
+ * LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE,ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+    Host benchmark of the topocentric right ascension, declination, altitude and azimuth of every
+    body for many observers.
+
+    build and run with:
+
+    make
+    ./planet_motion_topo_bench [-n observers] [start_day] [days]
+
+    Observers are scattered evenly over the Earth, and for each of days instants, an hour and a
+    quarter apart from start_day, the Sun and planets are turned to the horizon of every observer.
+    The time of each stage is reported with each kernel set, per observer for the sidereal time,
+    and per observer and body for the horizon, without and with the right ascension and declination.
+    A sample of observers is checked against the hour angle formulas of ppcomp.html, in double.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+#include "planet_motion.h"
+#include "planet_motion_simd.h"
+#include "planet_motion_topo.h"
+
+#define START_DAY           8766                                    // January 1st, 2024
+#define DAYS                64
+#define STEP                (1.25/24.0)                             // days between instants
+#define OBSERVERS           100000
+#define SAMPLE              101                                     // check every SAMPLE'th observer
+
+static uint16_t startDay = START_DAY;
+static uint16_t days = DAYS;
+static uint32_t count = OBSERVERS;
+
+static FLOAT * latitude, * longitude;
+static FLOAT * altitude, * azimuth, * ra, * dec;
+
+static volatile FLOAT sink;
+
+static double now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+// geocentric ecliptic positions of every body, the Sun and Moon from their orbits of the Earth
+static void geocentric (cartesian_coordinates_t * geo, FLOAT day)
+{
+    cartesian_coordinates_t s;
+    uint8_t p;
+
+    s.day = day;
+    sunEclipticCartesianCoordinates(&s);
+
+    for (p = 0; p < PLANETS; ++p) {
+        geo[p].day = day;
+        if (planets[p] == &sun) {
+            geo[p] = s;
+        } else if (planets[p] == &moon) {
+            planetEclipticCartesianCoordinates(&geo[p], planets[p]);
+        } else {
+            planetEclipticCartesianCoordinates(&geo[p], planets[p]);
+            addCartesianCoordinates(&geo[p], &s);
+        }
+    }
+}
+
+// the altitude and azimuth of equatorial position v (AU) for observer k, by the hour angle, in double
+static void reference (double * alt, double * az, const cartesian_coordinates_t * v, const topo_observers_t * o, uint32_t k, const topo_instant_t * instant)
+{
+    double lat = RAD(o->latitude[k]);
+    double geocentric = lat - RAD(0.1924) * sin(2 * lat);
+    double rho = (0.99833 + 0.00167 * cos(2 * lat)) / EARTH_RADII_PER_ASTRONOMICAL_UNIT;
+    double lst = RAD((double)instant->gmst + o->longitude[k]);
+    double x = v->x - rho * cos(geocentric) * cos(lst);
+    double y = v->y - rho * cos(geocentric) * sin(lst);
+    double z = v->z - rho * sin(geocentric);
+    double decl = atan2(z, sqrt(x * x + y * y));
+    double ha = lst - atan2(y, x);
+    double xh = cos(ha) * cos(decl) * sin(lat) - sin(decl) * cos(lat);
+    double yh = sin(ha) * cos(decl);
+    double zh = cos(ha) * cos(decl) * cos(lat) + sin(decl) * sin(lat);
+
+    *alt = DEG(asin(zh));
+    *az = fmod(DEG(atan2(yh, xh)) + 180.0 + 360.0, 360.0);
+}
+
+static void bench (const simd_kernels_t * kernels, topo_observers_t * observers)
+{
+    cartesian_coordinates_t geo[PLANETS], equatorial[PLANETS];
+    topo_instant_t instant;
+    double tInstant = 0.0, tHorizontal = 0.0, tRaDec = 0.0, t;
+    double worst = 0.0, alt, az, e;
+    uint32_t k;
+    uint16_t d;
+    uint8_t p;
+
+    if (!simdSelect(kernels))
+        return;
+
+    for (d = 0; d < days; ++d) {
+        FLOAT day = startDay + d * STEP;
+
+        geocentric(geo, day);
+
+        t = now();
+        topoInstant(&instant, day);
+        topoObserversInstant(observers, &instant);
+        tInstant += now() - t;
+
+        for (p = 0; p < PLANETS; ++p)
+            topoEquatorial(&equatorial[p], &geo[p], &instant);
+
+        t = now();
+        topoHorizontal(altitude, azimuth, NULL, NULL, observers, equatorial, PLANETS);
+        tHorizontal += now() - t;
+        sink = altitude[0];
+
+        t = now();
+        topoHorizontal(altitude, azimuth, ra, dec, observers, equatorial, PLANETS);
+        tRaDec += now() - t;
+        sink = ra[0];
+
+        for (p = 0; p < PLANETS; ++p) {
+            for (k = 0; k < count; k += SAMPLE) {
+                reference(&alt, &az, &equatorial[p], observers, k, &instant);
+                e = fabs(altitude[p * count + k] - alt);
+                if (e > worst)
+                    worst = e;
+                e = fabs(azimuth[p * count + k] - az);
+                e = (e > 180.0 ? 360.0 - e : e) * cos(RAD(alt));    // on the sky
+                if (e > worst)
+                    worst = e;
+            }
+        }
+    }
+
+    printf("%-8s %5u %12.2f %14.2f %14.2f %12.2e\n", kernels->name, kernels->lanes,
+            tInstant * 1.0e9 / ((double)days * count),
+            tHorizontal * 1.0e9 / ((double)days * count * PLANETS),
+            tRaDec * 1.0e9 / ((double)days * count * PLANETS), worst);
+}
+
+int main (int argc, char ** argv)
+{
+    topo_observers_t observers;
+    uint32_t k;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+            case 'n': count = (uint32_t)atol(optarg); break;
+            default: count = 0; break;
+        }
+    }
+    if (optind < argc) startDay = (uint16_t)atoi(argv[optind]);
+    if (optind + 1 < argc) days = (uint16_t)atoi(argv[optind + 1]);
+    if (count == 0 || days == 0) {
+        fprintf(stderr, "usage: %s [-n observers] [start_day] [days]\n", argv[0]);
+        return 1;
+    }
+
+    latitude = malloc(count * sizeof(FLOAT));
+    longitude = malloc(count * sizeof(FLOAT));
+    altitude = malloc((size_t)count * PLANETS * sizeof(FLOAT));
+    azimuth = malloc((size_t)count * PLANETS * sizeof(FLOAT));
+    ra = malloc((size_t)count * PLANETS * sizeof(FLOAT));
+    dec = malloc((size_t)count * PLANETS * sizeof(FLOAT));
+    if (latitude == NULL || longitude == NULL || altitude == NULL || azimuth == NULL || ra == NULL || dec == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    srand(1);
+    for (k = 0; k < count; ++k) {                                   // evenly over the sphere
+        latitude[k] = DEG(asin(2.0 * rand() / RAND_MAX - 1.0));
+        longitude[k] = 360.0 * rand() / RAND_MAX - 180.0;
+    }
+    if (!topoObserversInit(&observers, latitude, longitude, count)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    printf("%u observers, %u bodies, %u instants from day %u\n\n", count, PLANETS, days, startDay);
+    printf("%-8s %5s %12s %14s %14s %12s\n", "kernels", "lanes", "ns/observer", "ns/pair alt/az", "ns/pair +ra/dec", "error (deg)");
+
+    bench(&simdScalar, &observers);
+#if defined(__x86_64__)
+    bench(&simdSSE2, &observers);
+    bench(&simdAVX2, &observers);
+#endif
+
+    topoObserversFree(&observers);
+    free(latitude);
+    free(longitude);
+    free(altitude);
+    free(azimuth);
+    free(ra);
+    free(dec);
+    return 0;
+}
@@ -0,0 +1,120 @@
+
+#include <stdint.h>
+#include <math.h>
+
+#include "planet_motion.h"
+
+#if defined(PLANET_MOTION_DEGREES) || ! defined(__Z88DK)           // on the Z80, only with the builds that call it
+
+// Degree native trigonometry, so that SIN(RAD(x)) and DEG(ATAN2(y,x)) need no conversion.
+//
+// sin and cos use a table of whole degrees, and the angle sum identities with short polynomials
+// for the remaining h = [-0.5,0.5] degrees, having the radian conversion folded into their constants.
+// Angles are expected to come from rev(), in [0,360), but any angle is accepted.
+
+#define K1          1.745329252e-2          // (pi/180)             sin(h) ~ K1*h - K3*h^3
+#define K2          1.523087099e-4          // (pi/180)^2 / 2       cos(h) ~ 1 - K2*h^2
+#define K3          8.860961557e-7          // (pi/180)^3 / 6
+
+static const FLOAT sinTable[91] = {         // sin(k) for k = 0 to 90 degrees
+    0.000000000, 0.017452406, 0.034899497, 0.052335956, 0.069756474,
+    0.087155743, 0.104528463, 0.121869343, 0.139173101, 0.156434465,
+    0.173648178, 0.190808995, 0.207911691, 0.224951054, 0.241921896,
+    0.258819045, 0.275637356, 0.292371705, 0.309016994, 0.325568154,
+    0.342020143, 0.358367950, 0.374606593, 0.390731128, 0.406736643,
+    0.422618262, 0.438371147, 0.453990500, 0.469471563, 0.484809620,
+    0.500000000, 0.515038075, 0.529919264, 0.544639035, 0.559192903,
+    0.573576436, 0.587785252, 0.601815023, 0.615661475, 0.629320391,
+    0.642787610, 0.656059029, 0.669130606, 0.681998360, 0.694658370,
+    0.707106781, 0.719339800, 0.731353702, 0.743144825, 0.754709580,
+    0.766044443, 0.777145961, 0.788010754, 0.798635510, 0.809016994,
+    0.819152044, 0.829037573, 0.838670568, 0.848048096, 0.857167301,
+    0.866025404, 0.874619707, 0.882947593, 0.891006524, 0.898794046,
+    0.906307787, 0.913545458, 0.920504853, 0.927183855, 0.933580426,
+    0.939692621, 0.945518576, 0.951056516, 0.956304756, 0.961261696,
+    0.965925826, 0.970295726, 0.974370065, 0.978147601, 0.981627183,
+    0.984807753, 0.987688341, 0.990268069, 0.992546152, 0.994521895,
+    0.996194698, 0.997564050, 0.998629535, 0.999390827, 0.999847695,
+    1.000000000
+};
+
+// sin and cos of x in [0,90] degrees
+static void sincosQuadrant (FLOAT x, FLOAT * s, FLOAT * c)
+{
+    uint8_t k = (uint8_t)(x + 0.5);         // nearest whole degree
+    FLOAT h = x - k;
+    FLOAT h2 = h * h;
+    FLOAT sinh = h * (K1 - h2 * K3);
+    FLOAT cosh = 1.0 - h2 * K2;
+
+    *s = sinTable[k] * cosh + sinTable[90-k] * sinh;
+    *c = sinTable[90-k] * cosh - sinTable[k] * sinh;
+}
+
+void sincosd (FLOAT x, FLOAT * s, FLOAT * c)
+{
+    FLOAT sq, cq;
+    uint8_t quadrant = 0;
+
+    if (x < 0.0 || x >= 360.0) {
+        x = rev(x);
+        if (x >= 360.0)                     // a tiny negative x rounds up to 360
+            x = 0.0;
+    }
+
+    while (x >= 90.0) {
+        x -= 90.0;
+        ++quadrant;
+    }
+
+    sincosQuadrant(x, &sq, &cq);
+
+    switch (quadrant) {                     // sin(x + 90*quadrant)
+        case 0: *s = sq;  *c = cq;  break;
+        case 1: *s = cq;  *c = -sq; break;
+        case 2: *s = -sq; *c = -cq; break;
+        default: *s = -cq; *c = sq; break;
+    }
+}
+
+FLOAT sind (FLOAT x) __z88dk_fastcall
+{
+    FLOAT s, c;
+
+    sincosd(x, &s, &c);
+    return s;
+}
+
+FLOAT cosd (FLOAT x) __z88dk_fastcall
+{
+    FLOAT s, c;
+
+    sincosd(x, &s, &c);
+    return c;
+}
+
+// atan2 in degrees, on [-180,180], from the Abramowitz & Stegun 4.4.49 polynomial for atan
+// on [0,1] (error 2e-8 radians), with the 180/pi conversion folded into its coefficients
+FLOAT atan2d (FLOAT y, FLOAT x) __z88dk_callee
+{
+    FLOAT ax = FABS(x);
+    FLOAT ay = FABS(y);
+    FLOAT t, t2, a;
+
+    if (ax == 0.0 && ay == 0.0)
+        return 0.0;
+
+    t = (ay > ax) ? (ax / ay) : (ay / ax);
+    t2 = t * t;
+
+    a = (((((((-0.232280413 * t2 + 1.25255615) * t2 - 3.20340051) * t2 + 5.52446159) * t2
+            - 7.96900269) * t2 + 11.4285233) * t2 - 19.0966008) * t2 + 57.2957413) * t;
+
+    if (ay > ax) a = 90.0 - a;
+    if (x < 0.0) a = 180.0 - a;
+    if (y < 0.0) a = -a;
+
+    return a;
+}
+
+#endif